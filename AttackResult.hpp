@@ -1,6 +1,6 @@
 #ifndef ATTACKRESULT_HPP
 #define ATTACKRESULT_HPP
 
-enum AttackResult {miss, hit, sunk, won};
+enum AttackResult {miss, hit, sunk, won, alreadyAttacked};
 
 #endif
@@ -0,0 +1,92 @@
+#ifndef BATTLESHIPPLUGIN_H
+#define BATTLESHIPPLUGIN_H
+#include <stdint.h>
+
+/*
+The C interface of strategy plugins: shared libraries that the tournament and the interactive game load at run time
+(see `PluginStrategy.hpp`), so a computer player can be written in any language that can export C functions and
+still be called directly, without a process or a recompile of the game in between.
+
+A plugin exports one function, `battleship_plugin`, which returns a description of the plugin that stays valid as
+long as the plugin is loaded. Only fixed width types and plain structs cross the interface, and new members are
+only ever added at the end behind a new `BATTLESHIP_PLUGIN_API_VERSION`.
+
+Positions are numbered x + y*board_size. A plugin may be used by several threads at once, but each bot it creates
+is only used by one thread at a time.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BATTLESHIP_PLUGIN_API_VERSION 1
+
+#ifdef _WIN32
+#define BATTLESHIP_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define BATTLESHIP_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* The results of an attack, with the same values as `AttackResult`. */
+enum {
+    BATTLESHIP_MISS = 0,
+    BATTLESHIP_HIT = 1,
+    BATTLESHIP_SUNK = 2,
+    BATTLESHIP_WON = 3
+};
+
+/* The directions a ship goes from its first position, with the same values as in `getShipPositions`. */
+enum {
+    BATTLESHIP_UP = 0,
+    BATTLESHIP_DOWN = 1,
+    BATTLESHIP_LEFT = 2,
+    BATTLESHIP_RIGHT = 3
+};
+
+/*
+What the bot can see of the enemy's board. The planes are the bit-planes of the board itself, not copies:
+bit i % 64 of word i / 64 is set if position i has been attacked, or has been attacked and had a ship.
+They are read only and only valid during the call they are passed to.
+*/
+typedef struct BattleshipBoardView {
+    int32_t board_size;
+    /* Amount of 64 bit words in each plane. */
+    int32_t word_count;
+    const uint64_t* attacked;
+    const uint64_t* hit;
+    int32_t ships_left;
+    /* The sizes of the `ships_left` ships that have not been sunk, or NULL if they are not known. */
+    const int32_t* remaining_ship_sizes;
+} BattleshipBoardView;
+
+typedef struct BattleshipPlugin {
+    /* BATTLESHIP_PLUGIN_API_VERSION of the header the plugin was built with. */
+    int32_t api_version;
+    const char* name;
+
+    /* Creates a bot that plays one game at a time, and destroys it. */
+    void* (*create)(uint64_t seed);
+    void (*destroy)(void* bot);
+
+    /* Called before every game. May be NULL. */
+    void (*new_game)(void* bot, int32_t board_size);
+    /*
+    Places the fleet of `ship_count` ships of `ship_sizes` by writing x, y and the direction of every ship, in order,
+    to `placements` (3 * ship_count values). Returns 0 on success. May be NULL to have the ships placed at random.
+    */
+    int32_t (*place_ships)(void* bot, int32_t board_size, const int32_t* ship_sizes, int32_t ship_count, int32_t* placements);
+    /* Returns the position to attack, which should not have been attacked yet. */
+    int32_t (*choose_attack)(void* bot, const BattleshipBoardView* view);
+    /* Called with the result of every attack of the bot. May be NULL. */
+    void (*attack_result)(void* bot, int32_t position, int32_t result);
+} BattleshipPlugin;
+
+/* The function every plugin exports. */
+typedef const BattleshipPlugin* (*BattleshipPluginEntry)(void);
+#define BATTLESHIP_PLUGIN_ENTRY_NAME "battleship_plugin"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+// Counts the set bits in a 64 bit word.
+inline int popCount(uint64_t word) {
+#ifdef _MSC_VER
+    return (int) __popcnt64(word);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+// Returns the index of the lowest set bit of a word that is not 0.
+inline int lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int) index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// A set of bits, one per board position, packed into 64 bit words.
+// Used by the board as bit-planes so that whole-board questions become a few word operations.
+// A bitboard does not own its words; they live in the storage of whoever created it (e.g. a board's arena).
+class Bitboard {
+    private:
+        uint64_t* words;
+        int wordCount;
+        int bits;
+
+    public:
+        Bitboard() : words(NULL), wordCount(0), bits(0) {}
+        Bitboard(uint64_t* words, int bits) : words(words), wordCount(GetWordCount(bits)), bits(bits) {}
+
+        // Returns the amount of words needed to store the given amount of bits.
+        static int GetWordCount(int bits) {return (bits + 63) / 64;}
+
+        int GetSize() const {return bits;}
+        int GetWordCount() const {return wordCount;}
+        const uint64_t* GetWords() const {return words;}
+
+        bool Test(int index) const {return (words[index >> 6] >> (index & 63)) & 1;}
+        void Set(int index) {words[index >> 6] |= uint64_t(1) << (index & 63);}
+        void Reset(int index) {words[index >> 6] &= ~(uint64_t(1) << (index & 63));}
+
+        void Clear() {
+            for (int i=0; i<wordCount; i++) {
+                words[i] = 0;
+            }
+        }
+
+        // Returns the amount of set bits.
+        int Count() const {
+            int count = 0;
+            for (int i=0; i<wordCount; i++) {
+                count += popCount(words[i]);
+            }
+            return count;
+        }
+
+        // Returns the amount of bits that are not set, but stops counting once there are `limit` of them.
+        // Bits past the size are never set.
+        int CountUnset(int limit) const {
+            int count = 0;
+            for (int i=0; i<wordCount && count < limit; i++) {
+                int wordBits = i == wordCount-1 ? bits - 64*i : 64;
+                count += wordBits - popCount(words[i]);
+            }
+            return count < limit ? count : limit;
+        }
+
+        bool Any() const {
+            for (int i=0; i<wordCount; i++) {
+                if (words[i]) return true;
+            }
+            return false;
+        }
+
+        // Returns 'true' if every bit set in this set is also set in `other`.
+        bool IsSubsetOf(const Bitboard& other) const {
+            for (int i=0; i<wordCount; i++) {
+                if (words[i] & ~other.words[i]) return false;
+            }
+            return true;
+        }
+
+        // Returns 'true' if any bit is set in both this set and `other`.
+        bool Intersects(const Bitboard& other) const {
+            for (int i=0; i<wordCount; i++) {
+                if (words[i] & other.words[i]) return true;
+            }
+            return false;
+        }
+
+        // The operations below only look at words `firstWord` up to and including `lastWord`,
+        // for sets that are known to be empty elsewhere.
+        void Clear(int firstWord, int lastWord) {
+            for (int i=firstWord; i<=lastWord; i++) {
+                words[i] = 0;
+            }
+        }
+
+        bool Intersects(const Bitboard& other, int firstWord, int lastWord) const {
+            for (int i=firstWord; i<=lastWord; i++) {
+                if (words[i] & other.words[i]) return true;
+            }
+            return false;
+        }
+
+        // Adds every bit of `other` to this set.
+        void Unite(const Bitboard& other, int firstWord, int lastWord) {
+            for (int i=firstWord; i<=lastWord; i++) {
+                words[i] |= other.words[i];
+            }
+        }
+
+        // Adds every bit that is set in both `first` and `second` to this set.
+        void UniteIntersection(const Bitboard& first, const Bitboard& second, int firstWord, int lastWord) {
+            for (int i=firstWord; i<=lastWord; i++) {
+                words[i] |= first.words[i] & second.words[i];
+            }
+        }
+
+        // Returns 'true' if any bit is set in both this set and the mask `other` of the same word count.
+        bool Intersects(const uint64_t* other) const {
+            for (int i=0; i<wordCount; i++) {
+                if (words[i] & other[i]) return true;
+            }
+            return false;
+        }
+};
+
+#endif
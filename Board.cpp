@@ -0,0 +1,483 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <new>
+#include <algorithm>
+#include <type_traits>
+#include "Board.hpp"
+#include "Position.hpp"
+#include "Ship.hpp"
+#include "Bitboard.hpp"
+#include "PlacementMasks.hpp"
+#include "Snapshot.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+// The classes in this file hold the rules of the game and do not prompt the players,
+// so they are shared by the interactive game and the headless simulation.
+
+/*******************************************************************
+                SHIP CLASS
+********************************************************************/
+
+// A ship that is placed on board positions.
+Ship::Ship(int size){
+    this->size = size;
+    this->hp = size;
+};
+
+int Ship::GetSize(){return this->size;}
+int Ship::GetHP(){return this->hp;}
+bool Ship::IsSunk(){return this->hp == 0;}
+
+// Get hit by an attack. Lowers the ship's HP and returns an Attack result.
+AttackResult Ship::GetHit() {
+    this->hp --;
+    if (IsSunk()) {
+        return sunk;
+    } else {
+        return hit;
+    }
+}
+
+/*******************************************************************
+                POSITION CLASS
+********************************************************************/
+
+// A position on a board. May have a ship placed on it.
+// This is a view into the board's bit-planes, so it is cheap to create and copy.
+Position::Position(Board* board, int index) {
+   this->board = board;
+   this->index = index;
+};
+Position::~Position() {};
+
+int Position::GetIndex(){return this->index;}
+bool Position::HasShip(){return board->HasShip(index);}
+Ship* Position::GetShip(){return board->GetShip(index);}
+bool Position::HasBeenAttacked(){return board->HasBeenAttacked(index);}
+bool Position::HasBeenAttackedRecently(){return board->HasBeenAttackedRecently(index);}
+
+// Prints a string representing the state of this position.
+// Modifies the 'recent' attribute of the position when a full turn has passed.
+string Position::PositionString(bool showShip) {
+    if (HasShip()) {
+        string posLine = "| ";
+        if (showShip) {
+            posLine += "{";
+        } else {
+            posLine +=" ";
+        }
+        if (HasBeenAttacked()) {
+            if (HasBeenAttackedRecently()) {
+                posLine += "#";
+                if (!showShip) board->recentPlane.Reset(index);
+            } else {
+                posLine += "X";
+            }
+        } else {
+            posLine += " ";
+        }
+        if (showShip) {
+            posLine += "} ";
+        } else {
+            posLine +="  ";
+        }
+        return posLine;
+    } else {
+        string posLine = "| ";
+        posLine += " ";
+        if (HasBeenAttacked()) {
+            if (HasBeenAttackedRecently()) {
+                posLine += "@";
+                if (!showShip) board->recentPlane.Reset(index);
+            } else {
+                posLine += "O";
+            }
+        } else {
+            posLine += " ";
+        }
+        posLine +=  "  ";
+        return posLine;
+    }
+}
+
+// Get attacked. Marks the position as attacked recently.
+AttackResult Position::GetAttacked() {
+    return board->AttackPosition(index);
+}
+
+
+/*******************************************************************
+                BOARD CLASS
+********************************************************************/
+
+// A board that belongs to a player of a battleship game.
+// The state of the size*size positions is kept in bit-planes (ship, attacked, recent, hit, and a scratch plane for salvos)
+// and a small per position ship index, rather than in separately allocated positions.
+// All of it, including the ships, lives in one contiguous arena that is allocated once.
+Board::Board(string playerName, int size) {
+    this->playerName = playerName;
+    this->size = size;
+    this->shipsLeft=0;
+    this->shipCount=0;
+    // Ship ids are stored in a byte, so there can be at most 255 ships.
+    this->shipCapacity = min(size*size, 255);
+
+    int planeWords = Bitboard::GetWordCount(size*size);
+    int idWords = (size*size + 7) / 8;
+    int shipWords = (shipCapacity*sizeof(Ship) + 7) / 8;
+    this->arena.assign(5*planeWords + idWords + shipWords, 0);
+
+    uint64_t* words = arena.data();
+    this->shipPlane = Bitboard(words, size*size);
+    this->attackedPlane = Bitboard(words + planeWords, size*size);
+    this->recentPlane = Bitboard(words + 2*planeWords, size*size);
+    this->hitPlane = Bitboard(words + 3*planeWords, size*size);
+    this->salvoPlane = Bitboard(words + 4*planeWords, size*size);
+    this->shipIds = (uint8_t*) (words + 5*planeWords);
+    this->ships = (Ship*) (words + 5*planeWords + idWords);
+};
+Board::~Board(){};
+
+// Removes all ships and attacks from the board without releasing its arena.
+void Board::Reset() {
+    fill(arena.begin(), arena.end(), 0);
+    this->shipsLeft=0;
+    this->shipCount=0;
+}
+
+Position Board::GetPosition(int index) {
+    return Position(this, index);}
+
+void Board::GetRemainingShipSizes(vector<int>& sizes) {
+    sizes.clear();
+    for (int i=0; i<shipCount; i++) {
+        if (!ships[i].IsSunk()) {
+            sizes.push_back(ships[i].GetSize());
+        }
+    }
+}
+void Board::GetSunkShipSizes(vector<int>& sizes) {
+    sizes.clear();
+    for (int i=0; i<shipCount; i++) {
+        if (ships[i].IsSunk()) {
+            sizes.push_back(ships[i].GetSize());
+        }
+    }
+}
+string Board::GetPlayerName(){return this->playerName;};
+
+// Prints a board of a given size using pre made strings. 
+// Will print ships or not depending on the given `showShips` argument.
+void Board::PrintBoard(int size, bool showShips, map<int,string> preMadeStrings) {
+    string board = preMadeStrings[2] + preMadeStrings[1];
+    for (int y=0; y<size; y++) {
+        if (y != 0) {
+            board += preMadeStrings[4];
+        }
+        board += to_string(y) + " ";
+        for (int x=0; x<size; x++) {
+            board += GetPosition(x + y*size).PositionString(showShips);
+        }
+        board += "|\n";
+    }
+
+
+    board += preMadeStrings[3];
+    cout << board;
+}
+
+// Place a ship on the board on the given position indices.
+void Board::PlaceShip(const vector<int>& positionIndices, int shipSize) {
+    if (shipCount == shipCapacity) {
+        throw "There is no room for another ship on this board.";
+    }
+    new (ships + shipCount) Ship(shipSize);
+    this->shipCount ++;
+    this->shipsLeft ++;
+    for (int posIn: positionIndices) {
+        shipPlane.Set(posIn);
+        shipIds[posIn] = (uint8_t) shipCount;
+    }
+}
+
+// The arena is written and read as raw bytes, which is only well-defined for the ships if they can be copied as such.
+static_assert(is_trivially_copyable<Ship>::value, "Ships are copied byte for byte in board snapshots.");
+
+// Writes the board as a snapshot. Only the part of the arena up to the last placed ship is written.
+void Board::SaveSnapshot(ostream& out) {
+    const char zeros[8] = {0};
+    BoardSnapshotHeader header;
+    header.size = size;
+    header.shipsLeft = shipsLeft;
+    header.shipCount = shipCount;
+    header.nameLength = playerName.size();
+    header.arenaBytes = (const char*) (ships + shipCount) - (const char*) arena.data();
+    out.write((const char*) &header, sizeof(header));
+    out.write(playerName.data(), playerName.size());
+    out.write(zeros, (8 - playerName.size() % 8) % 8);
+    out.write((const char*) arena.data(), header.arenaBytes);
+}
+
+// Reads a board snapshot straight into the arena, the rest of the arena is cleared.
+void Board::LoadSnapshot(istream& in) {
+    BoardSnapshotHeader header;
+    if (!in.read((char*) &header, sizeof(header)) || header.size != size || header.shipCount < 0 || header.shipCount > shipCapacity
+        || header.shipsLeft < 0 || header.shipsLeft > header.shipCount || header.nameLength < 0 || header.nameLength > 4096
+        || header.arenaBytes != (uint64_t) ((const char*) (ships + header.shipCount) - (const char*) arena.data())) {
+        throw "The snapshot is not of a board of this size.";
+    }
+    string name(header.nameLength, ' ');
+    in.read(&name[0], name.size());
+    in.ignore((8 - name.size() % 8) % 8);
+    char* arenaBytes = (char*) arena.data();
+    in.read(arenaBytes, header.arenaBytes);
+    if (!in) {
+        Reset();
+        throw "The snapshot ends too early.";
+    }
+    fill(arenaBytes + header.arenaBytes, arenaBytes + arena.size()*sizeof(uint64_t), 0);
+    this->playerName = name;
+    this->shipsLeft = header.shipsLeft;
+    this->shipCount = header.shipCount;
+    if (!HasConsistentArena()) {
+        Reset();
+        throw "The snapshot does not hold a valid board.";
+    }
+}
+
+// Checks an arena read from a snapshot, which is used as it is: every position with a ship refers to a placed
+// ship, every ship covers as many positions as its size and has lost a hit point for each of them that was hit,
+// and the planes have no positions that are not on the board.
+bool Board::HasConsistentArena() {
+    int positions = size*size;
+    const Bitboard* planes[] = {&shipPlane, &attackedPlane, &recentPlane, &hitPlane};
+    for (const Bitboard* plane: planes) {
+        if (positions % 64 && plane->GetWords()[plane->GetWordCount()-1] >> (positions % 64)) {
+            return false;
+        }
+    }
+    if (salvoPlane.Any() || !recentPlane.IsSubsetOf(attackedPlane)) {
+        return false;
+    }
+    vector<int> shipPositions(shipCount, 0), shipHits(shipCount, 0);
+    for (int i=0; i<positions; i++) {
+        int id = shipIds[i];
+        if (id > shipCount || (id != 0) != shipPlane.Test(i) || hitPlane.Test(i) != (id != 0 && attackedPlane.Test(i))) {
+            return false;
+        }
+        if (id != 0) {
+            shipPositions[id-1]++;
+            shipHits[id-1] += hitPlane.Test(i);
+        }
+    }
+    int afloat = 0;
+    for (int i=0; i<shipCount; i++) {
+        if (ships[i].GetSize() != shipPositions[i] || ships[i].GetHP() != shipPositions[i] - shipHits[i]) {
+            return false;
+        }
+        afloat += ships[i].GetHP() > 0;
+    }
+    return afloat == shipsLeft;
+}
+
+// Attacks a single position. Marks the position as attacked recently.
+// Does not keep track of the amount of ships left, see `GetAttacked`.
+// A position that was attacked before is left as it is and reported as `alreadyAttacked`.
+AttackResult Board::AttackPosition(int posIndex) {
+    if (attackedPlane.Test(posIndex)) {
+        return alreadyAttacked;
+    }
+    attackedPlane.Set(posIndex);
+    recentPlane.Set(posIndex);
+    if (!shipPlane.Test(posIndex)) {
+        return miss;
+    }
+    hitPlane.Set(posIndex);
+    return ships[shipIds[posIndex]-1].GetHit();
+}
+
+// Get attacked on a certain position with given posIndex.
+// A position that is not on the board is refused like one that was attacked before.
+AttackResult Board::GetAttacked(int posIndex) {
+    METRICS_TIME(attackHistogram);
+    AttackResult result = posIndex >= 0 && posIndex < size*size ? AttackPosition(posIndex) : alreadyAttacked;
+    if (result == alreadyAttacked) {
+        METRICS_COUNT(invalidAttacksCounter, 1);
+        return result;
+    }
+    METRICS_COUNT(shotsCounter, 1);
+    if (result != miss) {
+        METRICS_COUNT(hitsCounter, 1);
+    }
+    if (result == sunk) {
+        METRICS_COUNT(sinksCounter, 1);
+        this->shipsLeft --;
+        if (shipsLeft == 0) {
+            return won;
+        }
+    }
+    return result;
+}
+
+// Attacks all `count` positions of a salvo at once, storing the result of every attack in `results` in the same order.
+// The salvo is applied as a whole or not at all: if a position is not on the board, was attacked before
+// or appears twice in the salvo, the board is left untouched and 'false' is returned.
+bool Board::GetAttackedSalvo(const int* positionIndices, int count, AttackResult* results) {
+    METRICS_TIME(attackHistogram);
+    // The salvo is collected in the scratch plane, keeping track of the words it touches.
+    int firstWord = salvoPlane.GetWordCount(), lastWord = -1;
+    for (int i=0; i<count; i++) {
+        int posIndex = positionIndices[i];
+        if (posIndex < 0 || posIndex >= size*size || salvoPlane.Test(posIndex)) {
+            salvoPlane.Clear(firstWord, lastWord);
+            METRICS_COUNT(invalidAttacksCounter, 1);
+            return false;
+        }
+        salvoPlane.Set(posIndex);
+        firstWord = min(firstWord, posIndex >> 6);
+        lastWord = max(lastWord, posIndex >> 6);
+    }
+    if (salvoPlane.Intersects(attackedPlane, firstWord, lastWord)) {
+        salvoPlane.Clear(firstWord, lastWord);
+        METRICS_COUNT(invalidAttacksCounter, 1);
+        return false;
+    }
+    // The planes are updated a word at a time; only attacks that hit a ship need to look at the ships.
+    attackedPlane.Unite(salvoPlane, firstWord, lastWord);
+    recentPlane.Unite(salvoPlane, firstWord, lastWord);
+    hitPlane.UniteIntersection(salvoPlane, shipPlane, firstWord, lastWord);
+    salvoPlane.Clear(firstWord, lastWord);
+    METRICS_COUNT(shotsCounter, count);
+    for (int i=0; i<count; i++) {
+        int posIndex = positionIndices[i];
+        AttackResult result = miss;
+        if (shipPlane.Test(posIndex)) {
+            METRICS_COUNT(hitsCounter, 1);
+            result = ships[shipIds[posIndex]-1].GetHit();
+            if (result == sunk) {
+                METRICS_COUNT(sinksCounter, 1);
+                this->shipsLeft --;
+                if (shipsLeft == 0) {
+                    result = won;
+                }
+            }
+        }
+        results[i] = result;
+    }
+    return true;
+}
+
+
+/*******************************************************************
+                BOARD HELPER FUNCTIONS
+********************************************************************/
+
+// Pre made strings used by `Board::PrintBoard`, for a board of the given size.
+string getTopLineString(int size) {
+    string line = "Y ";
+    for(int i=0; i<size; i++) {
+        line += "------"; 
+    }
+    line += "-\n";
+    return line;
+}
+
+string getXAxisString(int size) {
+    string axis = "  X";
+    for (int i=0; i<size; i++) {
+        axis += "  ";
+        axis += to_string(i);
+        axis += "   ";
+    };
+    axis += "\n";
+    return axis;
+}
+
+string getBottomLineString(int size) {
+    string line = "  ";
+    for(int i=0; i<size; i++) {
+        line +="------";
+    }
+    line += "-\n";
+    return line;
+};
+
+string getIntermediateLineString(int size) {
+    string line = "  |";
+    for(int i=0; i<size; i++) {
+        line += "- - - ";
+    }
+    line += "\b|\n";
+    return line;
+};
+
+// Checks to see if the positions intended for a ship fall within the game board.
+bool isLegalInitPositionAndOrientation(int x, int y, int orientation, int shipSize, int boardSize) {
+    bool legal;
+    if (getPlacementMask(boardSize, shipSize, x + y*boardSize, orientation, legal) != NULL) {
+        return legal;
+    }
+    if (orientation == 0) { // up
+        return y >= shipSize-1;
+    } else if (orientation ==1){ //down
+        return y + shipSize <= boardSize;
+    } else if (orientation ==2) { //left
+        return x >= shipSize-1;
+    } else { // right
+        return x + shipSize <= boardSize;
+    }   
+}
+
+// Calculates positions for a ship based on an intial position and an orientation.
+// `positionIndices` only holds the positions of the ship if it can be placed there, i.e. when `placed` is returned.
+PlacementResult getShipPositions(int initIndex, int orientation, int shipSize, int boardSize, Board& board, vector<int>& positionIndices) {
+    if (!isLegalInitPositionAndOrientation(initIndex % boardSize, initIndex / boardSize, orientation, shipSize, boardSize)) {
+        return offBoard;
+    }
+    // Make sure there are no ships in the positions of the new ship.
+    // With a placement mask table for this board this is a single AND against the ship plane.
+    bool legal;
+    const uint64_t* mask = getPlacementMask(boardSize, shipSize, initIndex, orientation, legal);
+    if (mask != NULL) {
+        if (board.GetShipPlane().Intersects(mask)) {
+            return overlap;
+        }
+    }
+    positionIndices.assign(1, initIndex);
+    // Get positions based on initIndex and orientation
+    if (orientation == 0) { // up
+        for(int i=boardSize; i<shipSize*boardSize; i+=boardSize) {
+            positionIndices.push_back(initIndex-i);
+        }
+    } else if (orientation ==1){ //down
+        for(int i=boardSize; i<shipSize*boardSize; i+=boardSize) {
+            positionIndices.push_back(initIndex+i);
+        }
+    } else if (orientation ==2) { //left
+        for(int i=1; i<shipSize; i++) {
+            positionIndices.push_back(initIndex-i);
+        }
+    } else { // right
+        for(int i=1; i<shipSize; i++) {
+            positionIndices.push_back(initIndex+i);
+        }
+    }
+    if (mask == NULL) {
+        for (int posIndex: positionIndices) {
+            if(board.HasShip(posIndex)) {
+                positionIndices.clear();
+                return overlap;
+            }
+        }
+    }
+    return placed;
+}
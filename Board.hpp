@@ -5,32 +5,91 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <cstdint>
 #include "Game.hpp"
+#include "Bitboard.hpp"
 #include "Position.hpp"
 #include "Ship.hpp"
 #include "AttackResult.hpp"
+#include "PlacementResult.hpp"
 
 using namespace std;
 
 class Board {
+    friend class Position;
+
     private:
-        vector<Position*> positions;
         string playerName;
+        int size;
         int shipsLeft;
+        int shipCount, shipCapacity;
+
+        // Single allocation holding all positions and ships of this board:
+        // the four bit-planes, then the per position ship ids, then the ships.
+        vector<uint64_t> arena;
+        // Bit-planes with one bit per position.
+        Bitboard shipPlane, attackedPlane, recentPlane, hitPlane;
+        // Scratch plane holding the positions of the salvo being checked by `GetAttackedSalvo`, empty otherwise.
+        Bitboard salvoPlane;
+        // Per position index into `ships`, offset by one so that 0 means no ship.
+        uint8_t* shipIds;
+        Ship* ships;
+
+        AttackResult AttackPosition(int positionIndex);
+        bool HasConsistentArena();
 
     public:
          Board(string playerName, int size);
         ~Board() ;
+        // The bit-planes point into the arena, so a board can not be copied.
+        Board(const Board&) = delete;
+        Board& operator=(const Board&) = delete;
 
-        Position* GetPosition(int index); //{return *(this->positions[index]);}
-        int GetShipsLeft(); // {return this->ships;};
+        // Removes all ships and attacks so that the board can be reused for a new game.
+        // Does not allocate.
+        void Reset();
+
+        Position GetPosition(int index); //{return Position(this, index);}
+        int GetSize() {return this->size;}
+        int GetShipsLeft() {return this->shipsLeft;}
+        // Sets `sizes` to the sizes of the ships that have not been sunk, in the order they were placed.
+        // The enemy learns these from the sunk results of its attacks.
+        void GetRemainingShipSizes(vector<int>& sizes);
+        // Sets `sizes` to the sizes of the ships that have been sunk, in the order they were placed.
+        void GetSunkShipSizes(vector<int>& sizes);
         string GetPlayerName(); //{return this->playerName;}
 
+        bool HasShip(int index) {return shipPlane.Test(index);}
+        bool HasBeenAttacked(int index) {return attackedPlane.Test(index);}
+        bool HasBeenAttackedRecently(int index) {return recentPlane.Test(index);}
+        Ship* GetShip(int index) {return shipIds[index] ? ships + shipIds[index]-1 : NULL;}
+        bool AllShipsSunk() {return shipPlane.IsSubsetOf(attackedPlane);}
+
+        const Bitboard& GetShipPlane() {return shipPlane;}
+        const Bitboard& GetAttackedPlane() {return attackedPlane;}
+        const Bitboard& GetRecentPlane() {return recentPlane;}
+        // Positions that were attacked and had a ship, i.e. what the enemy can see of the ships.
+        const Bitboard& GetHitPlane() {return hitPlane;}
+
         AttackResult GetAttacked(int postionIndex);
+        bool GetAttackedSalvo(const int* positionIndices, int count, AttackResult* results);
         void PrintBoard(int size, bool showShips, map<int,string> preMadeStrings);
-        void PlaceShip(vector<int> positionIndices, int shipSize);
+        void PlaceShip(const vector<int>& positionIndices, int shipSize);
+
+        // Snapshots, see `Snapshot.hpp`.
+        void SaveSnapshot(ostream& out);
+        // Restores a board saved with `SaveSnapshot`. Throws if the snapshot is not of a board of the same size.
+        void LoadSnapshot(istream& in);
 };
 
-#endif
+// Pre made strings used by `Board::PrintBoard`.
+string getTopLineString(int size);
+string getXAxisString(int size);
+string getBottomLineString(int size);
+string getIntermediateLineString(int size);
 
+bool isLegalInitPositionAndOrientation(int x, int y, int orientation, int shipSize, int boardSize);
+PlacementResult getShipPositions(int initIndex, int orientation, int shipSize, int boardSize, Board& board, vector<int>& positionIndices);
+
+#endif
 
@@ -0,0 +1,39 @@
+#ifndef BOARDDIMENSION_HPP
+#define BOARDDIMENSION_HPP
+
+using namespace std;
+
+// The size of a square board, fixed at compile time.
+// Code templated on a dimension is compiled for that size, so that loops over rows and positions have
+// constant bounds and position arithmetic becomes constant multiplications and shifts.
+template<int N>
+struct BoardDimension {
+    static constexpr int GetSize() {return N;}
+    static constexpr int GetIndex(int x, int y) {return x + y*N;}
+};
+
+// Generic fallback for boards whose size is only known at run time.
+template<>
+struct BoardDimension<0> {
+    int size;
+
+    explicit BoardDimension(int size) : size(size) {}
+
+    int GetSize() const {return size;}
+    int GetIndex(int x, int y) const {return x + y*size;}
+};
+
+// Calls `function` with the dimension of a board of the given size: a fixed dimension for the common
+// sizes 8, 10, 12 and 16, the generic one for any other size.
+template<typename Function>
+auto dispatchBoardSize(int size, Function function) -> decltype(function(BoardDimension<0>(size))) {
+    switch (size) {
+    case 8: return function(BoardDimension<8>());
+    case 10: return function(BoardDimension<10>());
+    case 12: return function(BoardDimension<12>());
+    case 16: return function(BoardDimension<16>());
+    default: return function(BoardDimension<0>(size));
+    }
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include "BoardRenderer.hpp"
+#include "Board.hpp"
+#include "Terminal.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+BoardRenderer::BoardRenderer(int boardSize, map<int,string> preMadeStrings, ostream& out) : out(out) {
+    this->boardSize = boardSize;
+    this->preMadeStrings = preMadeStrings;
+    Invalidate(1);
+};
+BoardRenderer::~BoardRenderer() {};
+
+void BoardRenderer::Invalidate(int topRow) {
+    this->topRow = topRow;
+    this->cursorInBoards = false;
+    frames.clear();
+}
+
+bool BoardRenderer::CanUpdateInPlace(int slots, int textRows) {
+    return GetSlotRow(slots) + textRows <= getTerminalRows();
+}
+
+void BoardRenderer::MoveCursor(int row, int column) {
+    output += "\033[";
+    output += to_string(row);
+    output += ";";
+    output += to_string(column);
+    output += "H";
+}
+
+// The first time a slot is drawn it is drawn completely at the cursor, afterwards only positions whose string changed are redrawn.
+// A board row takes two screen rows (the row and the line below it) after the x axis and the top line.
+void BoardRenderer::Draw(int slot, Board& board, bool showShips) {
+    METRICS_TIME(renderHistogram);
+    output.clear();
+    if ((int) frames.size() <= slot) {
+        frames.resize(slot+1, Frame{false, false, {}});
+    }
+    Frame& frame = frames[slot];
+    int cells = boardSize*boardSize;
+
+    if (!frame.drawn || frame.showShips != showShips) {
+        frame.drawn = true;
+        frame.showShips = showShips;
+        frame.cells.resize(cells);
+        // Otherwise the cursor is already where the previous slot, or the caller's text, ended.
+        if (cursorInBoards) {
+            MoveCursor(GetSlotRow(slot), 1);
+        }
+        output += preMadeStrings[2] + preMadeStrings[1] + "0 ";
+        for (int i=0; i<cells; i++) {
+            if (i % boardSize == 0 && i != 0) {
+                output += "|\n" + preMadeStrings[4] + to_string(i / boardSize) + " ";
+            }
+            frame.cells[i] = board.GetPosition(i).PositionString(showShips);
+            output += frame.cells[i];
+        }
+        output += "|\n";
+        output += preMadeStrings[3];
+        cursorInBoards = false;
+    } else {
+        int lastWritten = -2;
+        for (int i=0; i<cells; i++) {
+            string cell = board.GetPosition(i).PositionString(showShips);
+            if (cell != frame.cells[i]) {
+                int x = i % boardSize, y = i / boardSize;
+                // Changed positions next to each other on a row are written without moving the cursor in between.
+                if (lastWritten != i-1 || x == 0) {
+                    // Rows are prefixed by their number and a space.
+                    int column = to_string(y).size() + 2 + 6*x;
+                    MoveCursor(GetSlotRow(slot) + 2 + 2*y, column);
+                }
+                lastWritten = i;
+                output += cell;
+                frame.cells[i] = cell;
+                cursorInBoards = true;
+            }
+        }
+    }
+    out << output;
+}
+
+// After a complete draw the cursor already is below the board, and there is nothing below it to clear.
+void BoardRenderer::MoveBelowBoards() {
+    output.clear();
+    if (cursorInBoards) {
+        MoveCursor(GetSlotRow(frames.size()), 1);
+        output += "\033[J";
+        cursorInBoards = false;
+    }
+    out << output << flush;
+}
+
+void BoardRenderer::ClearBelowBoards() {
+    cursorInBoards = true;
+    MoveBelowBoards();
+}
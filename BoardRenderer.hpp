@@ -0,0 +1,58 @@
+#ifndef BOARDRENDERER_HPP
+#define BOARDRENDERER_HPP
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include "Board.hpp"
+
+using namespace std;
+
+// Rows reserved below the boards for prompts.
+const int promptRows = 8;
+
+// Draws boards to an ANSI terminal in the same layout as `Board::PrintBoard`.
+// Boards are drawn in slots stacked from a given screen row downwards, in order. The renderer remembers
+// what it drew in every slot, so drawing a slot again only rewrites the positions that changed,
+// each with a cursor movement, instead of the whole board.
+class BoardRenderer {
+    private:
+        struct Frame {
+            bool drawn;
+            bool showShips;
+            vector<string> cells;
+        };
+
+        int boardSize;
+        int topRow;
+        map<int,string> preMadeStrings;
+        vector<Frame> frames;
+        string output;
+        ostream& out;
+        // Whether the cursor has been moved into a board since the last complete draw.
+        bool cursorInBoards;
+
+        int GetSlotRow(int slot) {return topRow + slot*(2*boardSize + 2);}
+        void MoveCursor(int row, int column);
+
+    public:
+        BoardRenderer(int boardSize, map<int,string> preMadeStrings, ostream& out);
+        ~BoardRenderer();
+
+        // Forgets everything that was drawn, e.g. after the screen was cleared.
+        // `topRow` is the screen row (starting at 1) of the first slot from now on.
+        void Invalidate(int topRow);
+        // Draws a board in a slot. Modifies the 'recent' state of positions like `Board::PrintBoard`.
+        void Draw(int slot, Board& board, bool showShips);
+        // Moves the cursor below the last slot drawn and clears everything after it, if it is not there already.
+        void MoveBelowBoards();
+        // Same, but also when the cursor is already below the boards, e.g. to clear text written there.
+        void ClearBelowBoards();
+        // Returns 'true' if the given amount of slots fit on the terminal, with `textRows` rows for prompts below.
+        // Otherwise the terminal scrolls and drawn positions can not be updated in place.
+        bool CanUpdateInPlace(int slots, int textRows = promptRows);
+        // Amount of bytes written by the last call to `Draw`.
+        int GetLastDrawSize() {return output.size();}
+};
+
+#endif
@@ -0,0 +1,223 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <string>
+#include <future>
+#include <exception>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "BotProcess.hpp"
+#include "BotProtocol.hpp"
+#include "Board.hpp"
+
+using namespace std;
+
+static const char* rulesetWords[2] = {"CLASSIC", "SALVO"};
+
+/*******************************************************************
+                BOT PROCESS
+********************************************************************/
+
+BotProcess::BotProcess(const string& command) {
+    this->command = command;
+    // A bot that ends early should be reported, not end the harness.
+    signal(SIGPIPE, SIG_IGN);
+    int toBot[2], fromBot[2];
+    if (pipe(toBot) != 0) {
+        throw "Could not start the bot.";
+    }
+    if (pipe(fromBot) != 0) {
+        close(toBot[0]);
+        close(toBot[1]);
+        throw "Could not start the bot.";
+    }
+    this->pid = fork();
+    if (pid == 0) {
+        dup2(toBot[0], 0);
+        dup2(fromBot[1], 1);
+        close(toBot[0]);
+        close(toBot[1]);
+        close(fromBot[0]);
+        close(fromBot[1]);
+        execl("/bin/sh", "sh", "-c", command.c_str(), (char*) NULL);
+        _exit(127);
+    }
+    close(toBot[0]);
+    close(fromBot[1]);
+    if (pid < 0) {
+        close(toBot[1]);
+        close(fromBot[0]);
+        throw "Could not start the bot.";
+    }
+    fcntl(toBot[1], F_SETFD, FD_CLOEXEC);
+    // Writes never wait, see `Flush`.
+    fcntl(toBot[1], F_SETFL, fcntl(toBot[1], F_GETFL) | O_NONBLOCK);
+    fcntl(fromBot[0], F_SETFD, FD_CLOEXEC);
+    this->writer.reset(new BotWriter(toBot[1]));
+    this->reader.reset(new LineReader(fromBot[0], NULL));
+};
+
+BotProcess::~BotProcess() {
+    writer->Flush();
+    close(writer->GetFd());
+    close(reader->GetFd());
+    waitpid(pid, NULL, 0);
+};
+
+future<void> BotProcess::RequestPlacement(int game, Ruleset ruleset, Board& board, const vector<int>& shipSizes) {
+    PendingRequest& request = pending[game];
+    request.type = placeCommand;
+    request.placed = promise<void>();
+    request.board = &board;
+    request.shipSizes = &shipSizes;
+    request.shipsPlaced = 0;
+    unsent.push_back(game);
+    writer->Write(game);
+    writer->Write(" GAME ");
+    writer->Write(rulesetWords[ruleset]);
+    writer->Write(' ');
+    writer->Write(board.GetSize());
+    for (int shipSize: shipSizes) {
+        writer->Write(' ');
+        writer->Write(shipSize);
+    }
+    writer->Write('\n');
+    return request.placed.get_future();
+}
+
+future<vector<int>> BotProcess::RequestAttack(int game, int boardSize, int count) {
+    PendingRequest& request = pending[game];
+    request.type = fireCommand;
+    request.attack = promise<vector<int>>();
+    request.boardSize = boardSize;
+    request.count = count;
+    unsent.push_back(game);
+    writer->Write(game);
+    writer->Write(" TURN ");
+    writer->Write(count);
+    writer->Write('\n');
+    return request.attack.get_future();
+}
+
+void BotProcess::SendResults(int game, const vector<AttackResult>& results) {
+    writer->Write(game);
+    writer->Write(" RESULT");
+    for (AttackResult result: results) {
+        writer->Write(' ');
+        writer->Write(getAttackResultWord(result));
+    }
+    writer->Write('\n');
+}
+
+void BotProcess::SendEnd(int game, bool won) {
+    writer->Write(game);
+    writer->Write(won ? " END WON\n" : " END LOST\n");
+}
+
+// A bot that writes a large batch of answers may wait for them to be read before it reads more requests, so the
+// answers are read in (and handled later by `ReadAnswers`) while the requests do not fit in the pipe.
+void BotProcess::Flush() {
+    while (!writer->FlushAvailable()) {
+        pollfd fds[2] = {{writer->GetFd(), POLLOUT, 0}, {reader->GetFd(), POLLIN, 0}};
+        poll(fds, 2, -1);
+        if (fds[1].revents) {
+            reader->Fill();
+        }
+    }
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    for (int game: unsent) {
+        pending[game].sentAt = now;
+    }
+    unsent.clear();
+}
+
+bool BotProcess::HandleBufferedAnswers() {
+    const char* begin, * end;
+    bool handled = false;
+    while (reader->NextBufferedLine(begin, end)) {
+        HandleAnswer(begin, end);
+        handled = true;
+    }
+    return handled;
+}
+
+void BotProcess::ReadAnswers() {
+    if (!HandleBufferedAnswers()) {
+        if (!reader->Fill()) {
+            throw "The bot ended in the middle of a game.";
+        }
+        HandleBufferedAnswers();
+    }
+}
+
+void BotProcess::HandleAnswer(const char* begin, const char* end) {
+    int game;
+    if (!parseGameNumber(begin, end, game) || !parseBotCommand(begin, end, answer) || pending.count(game) == 0 || pending[game].type != answer.type) {
+        throw "The bot answered something it was not asked.";
+    }
+    PendingRequest& request = pending[game];
+    if (answer.type == placeCommand) {
+        Board& board = *request.board;
+        int boardSize = board.GetSize();
+        int shipSize = (*request.shipSizes)[request.shipsPlaced];
+        PlacementResult result = offBoard;
+        if (answer.x >= 0 && answer.x < boardSize && answer.y >= 0 && answer.y < boardSize) {
+            result = getShipPositions(answer.x + answer.y*boardSize, answer.orientation, shipSize, boardSize, board, positionIndices);
+        }
+        if (result != placed) {
+            request.placed.set_exception(make_exception_ptr("The bot placed a ship where it does not fit."));
+            pending.erase(game);
+            return;
+        }
+        board.PlaceShip(positionIndices, shipSize);
+        if (++request.shipsPlaced == request.shipSizes->size()) {
+            request.placed.set_value();
+            pending.erase(game);
+        }
+    } else if (answer.type == fireCommand) {
+        moveLatencies.push_back(chrono::duration<double>(chrono::steady_clock::now() - request.sentAt).count());
+        vector<int> positions;
+        int boardSize = request.boardSize;
+        for (size_t i=0; i<answer.coordinates.size(); i+=2) {
+            int x = answer.coordinates[i], y = answer.coordinates[i+1];
+            if (x < 0 || x >= boardSize || y < 0 || y >= boardSize) {
+                break;
+            }
+            positions.push_back(x + y*boardSize);
+        }
+        // Positions that were attacked before are refused by the game, which then asks again.
+        if ((int) positions.size() != request.count) {
+            request.attack.set_exception(make_exception_ptr("The bot attacked the wrong amount of positions or off the board."));
+        } else {
+            request.attack.set_value(positions);
+        }
+        pending.erase(game);
+    }
+}
+
+/*******************************************************************
+                BOT PLAYER
+********************************************************************/
+
+future<void> BotPlayer::PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+    return process.RequestPlacement(game, ruleset, ownBoard, shipSizes);
+}
+
+future<vector<int>> BotPlayer::ChooseAttack(Board& /*ownBoard*/, const EnemyBoardView& enemyBoard, int count) {
+    pendingResults = count;
+    return process.RequestAttack(game, enemyBoard.GetSize(), count);
+}
+
+void BotPlayer::ReceiveAttackResult(int /*positionIndex*/, AttackResult result) {
+    results.push_back(result);
+    if (--pendingResults == 0) {
+        process.SendResults(game, results);
+        results.clear();
+    }
+}
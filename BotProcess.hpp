@@ -0,0 +1,100 @@
+#ifndef BOTPROCESS_HPP
+#define BOTPROCESS_HPP
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <unordered_map>
+#include "Board.hpp"
+#include "Player.hpp"
+#include "BotProtocol.hpp"
+#include "Ruleset.hpp"
+
+using namespace std;
+
+// A bot running in another process, which plays any number of games at once over its standard input and output
+// (see the bot side of `BotProtocol.hpp`). Unix only.
+//
+// Requests of all games are collected and written together by `Flush`, and answers are taken in with `ReadAnswers`
+// as they come, so a fast bot pays for one write and one read per batch rather than per shot. The time from writing
+// an attack request to reading its answer is kept per move.
+class BotProcess {
+    private:
+        struct PendingRequest {
+            BotCommandType type;
+            // The placement of the fleet on `board`, ship by ship.
+            promise<void> placed;
+            Board* board;
+            const vector<int>* shipSizes;
+            size_t shipsPlaced;
+            // The positions to attack.
+            promise<vector<int>> attack;
+            int boardSize, count;
+            chrono::steady_clock::time_point sentAt;
+        };
+
+        string command;
+        int pid;
+        unique_ptr<BotWriter> writer;
+        unique_ptr<LineReader> reader;
+        unordered_map<int, PendingRequest> pending;
+        // Games with a request written since the last flush.
+        vector<int> unsent;
+        BotCommand answer;
+        vector<int> positionIndices;
+        vector<double> moveLatencies;
+
+        void HandleAnswer(const char* begin, const char* end);
+
+    public:
+        // Starts `command` with the shell. Throws if it can not be started.
+        BotProcess(const string& command);
+        // Closes the input of the bot and waits for it to end.
+        ~BotProcess();
+
+        const string& GetCommand() {return command;}
+        // The file descriptor to wait on for answers.
+        int GetAnswerFd() {return reader->GetFd();}
+        // Whether a request has not been answered yet.
+        bool IsWaiting() {return !pending.empty();}
+        // Seconds between writing every attack request and reading its answer.
+        const vector<double>& GetMoveLatencies() {return moveLatencies;}
+
+        // Asks the bot to place the fleet of `shipSizes` on `board` for a new game. The ships are placed as they come in.
+        // The future throws if the bot places a ship where it does not fit.
+        future<void> RequestPlacement(int game, Ruleset ruleset, Board& board, const vector<int>& shipSizes);
+        // Asks the bot for `count` positions to attack. The future throws if the bot answers with fewer or more,
+        // or with positions off the board.
+        future<vector<int>> RequestAttack(int game, int boardSize, int count);
+        void SendResults(int game, const vector<AttackResult>& results);
+        void SendEnd(int game, bool won);
+
+        // Writes all requests collected so far. Answers that arrive meanwhile are kept for `ReadAnswers`.
+        void Flush();
+        // Handles the answers that have been read in already, without waiting. Returns 'false' if there were none.
+        bool HandleBufferedAnswers();
+        // Handles the answers the bot has written so far; only waits if there are none yet.
+        // Throws if the bot ended or answered something it was not asked.
+        void ReadAnswers();
+};
+
+// One side of one game played by a bot process.
+class BotPlayer: public Player {
+    private:
+        BotProcess& process;
+        int game;
+        Ruleset ruleset;
+        int pendingResults;
+        vector<AttackResult> results;
+
+    public:
+        BotPlayer(BotProcess& process, int game, Ruleset ruleset) : process(process), game(game), ruleset(ruleset), pendingResults(0) {}
+
+        future<void> PlaceShips(Board& ownBoard, const vector<int>& shipSizes);
+        future<vector<int>> ChooseAttack(Board& ownBoard, const EnemyBoardView& enemyBoard, int count);
+        // The results of a turn are sent together.
+        void ReceiveAttackResult(int positionIndex, AttackResult result);
+};
+
+#endif
@@ -0,0 +1,296 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <string>
+#include <charconv>
+#include <algorithm>
+#include <string.h>
+#include <errno.h>
+#include "BotProtocol.hpp"
+#include "Metrics.hpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Size of the blocks read at once. A script of thousands of games is read in a handful of reads.
+const size_t readSize = 1 << 16;
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Moves `p` to the start of the next word and returns 'true' if there is one.
+static bool skipSpaces(const char*& p, const char* end) {
+    while (p < end && isSpace(*p)) {
+        p++;
+    }
+    return p < end;
+}
+
+// Reads the next word and compares it to `word`.
+static bool readWord(const char*& p, const char* end, const char* word) {
+    if (!skipSpaces(p, end)) {
+        return false;
+    }
+    size_t length = strlen(word);
+    if ((size_t) (end - p) < length || memcmp(p, word, length) != 0 || (p + length < end && !isSpace(p[length]))) {
+        return false;
+    }
+    p += length;
+    return true;
+}
+
+static bool readInt(const char*& p, const char* end, int& value) {
+    if (!skipSpaces(p, end)) {
+        return false;
+    }
+    from_chars_result result = from_chars(p, end, value);
+    if (result.ec != errc() || (result.ptr < end && !isSpace(*result.ptr))) {
+        return false;
+    }
+    p = result.ptr;
+    return true;
+}
+
+bool parseBotCommand(const char* begin, const char* end, BotCommand& command) {
+    const char* p = begin;
+    bool valid = false;
+    if (readWord(p, end, "FIRE")) {
+        command.type = fireCommand;
+        command.coordinates.clear();
+        int coordinate;
+        while (readInt(p, end, coordinate)) {
+            command.coordinates.push_back(coordinate);
+        }
+        valid = !command.coordinates.empty() && command.coordinates.size() % 2 == 0;
+    } else if (readWord(p, end, "PLACE")) {
+        command.type = placeCommand;
+        if (readInt(p, end, command.x) && readInt(p, end, command.y) && skipSpaces(p, end)) {
+            const char* orientations = "UDLR";
+            const char* orientation = strchr(orientations, *p);
+            if (*p != '\0' && orientation != NULL) {
+                command.orientation = orientation - orientations;
+                p++;
+                valid = true;
+            }
+        }
+    } else if (readWord(p, end, "GAME")) {
+        command.type = gameCommand;
+        command.boardSize = 10;
+        command.shipSizes.clear();
+        if (readWord(p, end, "CLASSIC")) {
+            command.ruleset = classic;
+            valid = true;
+        } else if (readWord(p, end, "SALVO")) {
+            command.ruleset = salvo;
+            valid = true;
+        }
+        if (valid && skipSpaces(p, end)) {
+            valid = readInt(p, end, command.boardSize);
+        }
+        int shipSize;
+        while (valid && readInt(p, end, shipSize)) {
+            command.shipSizes.push_back(shipSize);
+        }
+    } else if (readWord(p, end, "TURN")) {
+        command.type = turnCommand;
+        valid = readInt(p, end, command.count);
+    } else if (readWord(p, end, "RESULT")) {
+        command.type = resultCommand;
+        command.results.clear();
+        const AttackResult results[4] = {miss, hit, sunk, won};
+        bool found = true;
+        while (found) {
+            found = false;
+            for (AttackResult result: results) {
+                if (readWord(p, end, getAttackResultWord(result))) {
+                    command.results.push_back(result);
+                    found = true;
+                    break;
+                }
+            }
+        }
+        valid = !command.results.empty();
+    } else if (readWord(p, end, "END")) {
+        command.type = endCommand;
+        command.won = readWord(p, end, "WON");
+        valid = command.won || readWord(p, end, "LOST");
+    }
+    // Nothing may follow the command.
+    if (!valid || skipSpaces(p, end)) {
+        command.type = invalidCommand;
+        return false;
+    }
+    return true;
+}
+
+bool parseGameNumber(const char*& begin, const char* end, int& game) {
+    return readInt(begin, end, game);
+}
+
+bool isPlayableGame(int boardSize, const vector<int>& shipSizes) {
+    if (boardSize < 1 || boardSize > 100 || shipSizes.empty() || shipSizes.size() > 255) {
+        return false;
+    }
+    int positions = 0;
+    for (int shipSize: shipSizes) {
+        if (shipSize < 1 || shipSize > boardSize) {
+            return false;
+        }
+        positions += shipSize;
+    }
+    return positions <= boardSize*boardSize;
+}
+
+const char* getAttackResultWord(AttackResult result) {
+    switch (result) {
+    case miss:
+        return "MISS";
+    case hit:
+        return "HIT";
+    case sunk:
+        return "SUNK";
+    case won:
+        return "WON";
+    default:
+        return "ATTACKED";
+    }
+}
+
+const char* getPlacementResultWord(PlacementResult result) {
+    switch (result) {
+    case offBoard:
+        return "offboard";
+    case overlap:
+        return "overlap";
+    default:
+        return "placed";
+    }
+}
+
+/*******************************************************************
+                BOT WRITER
+********************************************************************/
+
+void BotWriter::Write(int number) {
+    char digits[12];
+    buffer.append(digits, to_chars(digits, digits + sizeof(digits), number).ptr);
+}
+
+void BotWriter::Flush() {
+    size_t written = 0;
+    while (written < buffer.size()) {
+#ifdef _WIN32
+        int count = _write(fd, buffer.data() + written, buffer.size() - written);
+#else
+        ssize_t count = write(fd, buffer.data() + written, buffer.size() - written);
+#endif
+        if (count <= 0) {
+            // Whoever reads the answers is gone, so they can not be delivered anyway.
+            break;
+        }
+        written += count;
+    }
+    buffer.clear();
+}
+
+bool BotWriter::FlushAvailable() {
+    size_t written = 0;
+    while (written < buffer.size()) {
+#ifdef _WIN32
+        int count = _write(fd, buffer.data() + written, buffer.size() - written);
+#else
+        ssize_t count = write(fd, buffer.data() + written, buffer.size() - written);
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            buffer.erase(0, written);
+            return false;
+        }
+#endif
+        if (count <= 0) {
+            break;
+        }
+        written += count;
+    }
+    buffer.clear();
+    return true;
+}
+
+/*******************************************************************
+                LINE READER
+********************************************************************/
+
+LineReader::LineReader(int fd, BotWriter* writer) : buffer(readSize) {
+    this->fd = fd;
+    this->start = 0;
+    this->end = 0;
+    this->searched = 0;
+    this->endOfInput = false;
+    this->writer = writer;
+};
+
+bool LineReader::ReadLine(const char*& lineBegin, const char*& lineEnd) {
+    while (!NextBufferedLine(lineBegin, lineEnd)) {
+        if (!Fill()) {
+            return NextBufferedLine(lineBegin, lineEnd);
+        }
+    }
+    return true;
+}
+
+bool LineReader::NextBufferedLine(const char*& lineBegin, const char*& lineEnd) {
+    const char* lineBreak = (const char*) memchr(buffer.data() + searched, '\n', end - searched);
+    if (lineBreak == NULL) {
+        searched = end;
+        // At the end of the input, the last line may lack a line break.
+        if (!endOfInput || start == end) {
+            return false;
+        }
+        lineBreak = buffer.data() + end;
+    }
+    lineBegin = buffer.data() + start;
+    lineEnd = lineBreak;
+    start = searched = min(lineBreak - buffer.data() + 1, (ptrdiff_t) end);
+    return true;
+}
+
+bool LineReader::Fill() {
+    if (endOfInput) {
+        return false;
+    }
+    // Keep the start of the line and make room behind it for the next block.
+    memmove(buffer.data(), buffer.data() + start, end - start);
+    end -= start;
+    searched -= start;
+    start = 0;
+    if (buffer.size() - end < readSize) {
+        buffer.resize(end + readSize);
+    }
+    if (writer) {
+        writer->Flush();
+    }
+    METRICS_TIME(inputWaitHistogram);
+    while (true) {
+#ifdef _WIN32
+        int count = _read(fd, buffer.data() + end, readSize);
+#else
+        ssize_t count = read(fd, buffer.data() + end, readSize);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (count <= 0) {
+            endOfInput = true;
+            return false;
+        }
+        end += count;
+        return true;
+    }
+}
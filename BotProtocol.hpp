@@ -0,0 +1,113 @@
+#ifndef BOTPROTOCOL_HPP
+#define BOTPROTOCOL_HPP
+#include <vector>
+#include <string>
+#include "AttackResult.hpp"
+#include "PlacementResult.hpp"
+#include "Ruleset.hpp"
+
+using namespace std;
+
+// The line protocol of `battleship --protocol`, for bots and scripts that play without the prompts.
+//
+// Every command is one line of words separated by spaces, and gets exactly one line back:
+//   GAME CLASSIC|SALVO [SIZE [SHIP ...]]
+//                               Starts a new game on a board of SIZE (10 by default), abandoning the current one.
+//                               The sizes of the ships of the fleet can follow (5 4 3 3 2 by default). Answered with "OK".
+//   PLACE X Y U|D|L|R           Places the next ship of the fleet from (X, Y) up, down, left or right.
+//                               Player one places all of its ships first, then player two. Answered with "OK".
+//   FIRE X Y [X Y ...]          Attacks the given positions for the player whose turn it is: one in a classic game,
+//                               one per own ship left in a salvo game. Answered with the result of every position,
+//                               e.g. "HIT MISS SUNK". A "WON" result ends the game.
+// A command that can not be carried out is answered with "ERR" and the reason, and changes nothing.
+// Commands can be sent all at once; the answers are written in batches, and at the latest whenever
+// the game waits for more commands.
+//
+// The same words are used the other way around by bots in another process (see `BotProcess.hpp`), which play
+// any number of games at once. Every line starts with the number of the game it is about. The bot is sent:
+//   ID GAME CLASSIC|SALVO SIZE SHIP ...   A new game. The bot answers with one "ID PLACE X Y U|D|L|R" line per ship.
+//   ID TURN COUNT                         The bot answers with "ID FIRE X Y ..." with COUNT positions.
+//   ID RESULT MISS|HIT|SUNK|WON ...       The results of the last FIRE of the bot. Not answered.
+//   ID END WON|LOST                       The game is over. Not answered.
+// The bot may answer in any order and should write its answers in batches, at the latest before it waits for input.
+
+enum BotCommandType {gameCommand, placeCommand, fireCommand, turnCommand, resultCommand, endCommand, invalidCommand};
+
+struct BotCommand {
+    BotCommandType type;
+    // GAME
+    Ruleset ruleset;
+    int boardSize;
+    // Empty if the GAME command did not give the fleet.
+    vector<int> shipSizes;
+    // PLACE
+    int x, y, orientation;
+    // FIRE: the coordinates of all shots, as x and y after each other.
+    vector<int> coordinates;
+    // TURN
+    int count;
+    // RESULT
+    vector<AttackResult> results;
+    // END
+    bool won;
+};
+
+// Parses the line from `begin` to `end` (without the line break) into `command`.
+// Returns 'false' and sets the type to `invalidCommand` if the line is not a valid command.
+bool parseBotCommand(const char* begin, const char* end, BotCommand& command);
+// Reads the number of the game at the start of a line between a bot and its harness and moves `begin` past it.
+bool parseGameNumber(const char*& begin, const char* end, int& game);
+
+// Whether a game on a board of `boardSize` with the fleet `shipSizes` can be played: the board is at most 100 wide,
+// and the fleet has at most 255 ships that fit on the board.
+bool isPlayableGame(int boardSize, const vector<int>& shipSizes);
+
+// The words used for results in answers: "MISS", "HIT", "SUNK" and "WON", and "offboard" and "overlap" after "ERR".
+const char* getAttackResultWord(AttackResult result);
+const char* getPlacementResultWord(PlacementResult result);
+
+// Collects answers and writes them to a file descriptor in as few writes as possible.
+class BotWriter {
+    private:
+        int fd;
+        string buffer;
+
+    public:
+        BotWriter(int fd) : fd(fd) {}
+        ~BotWriter() {Flush();}
+
+        void Write(const char* text) {buffer += text;}
+        void Write(char c) {buffer += c;}
+        void Write(int number);
+        int GetFd() {return fd;}
+        void Flush();
+        // Writes as much as a non-blocking file descriptor takes without waiting, and keeps the rest.
+        // Returns 'true' once everything is written.
+        bool FlushAvailable();
+};
+
+// Reads lines from a file descriptor, a large block at a time.
+class LineReader {
+    private:
+        int fd;
+        vector<char> buffer;
+        // Unread input is from `start` to `end`, and has no line break before `searched`.
+        size_t start, end, searched;
+        bool endOfInput;
+        // Written out before the reader waits for input, so a bot that waits for an answer gets it.
+        BotWriter* writer;
+
+    public:
+        LineReader(int fd, BotWriter* writer);
+
+        // Sets `begin` and `end` to the next line, without the line break. Returns 'false' at the end of the input.
+        // The line stays valid until the next call.
+        bool ReadLine(const char*& begin, const char*& end);
+        // Like `ReadLine`, but only returns a line that has been read already and never waits.
+        bool NextBufferedLine(const char*& begin, const char*& end);
+        // Reads the next block of input, waiting until there is some. Returns 'false' at the end of the input.
+        bool Fill();
+        int GetFd() {return fd;}
+};
+
+#endif
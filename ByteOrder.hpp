@@ -0,0 +1,28 @@
+#ifndef BYTEORDER_HPP
+#define BYTEORDER_HPP
+#include <cstdint>
+
+using namespace std;
+
+// Little endian numbers in byte buffers, as used by the game record format and the server protocol.
+
+inline uint16_t readUint16(const uint8_t* bytes) {
+    return bytes[0] | bytes[1] << 8;
+}
+
+inline void writeUint16(uint8_t* bytes, uint16_t value) {
+    bytes[0] = (uint8_t) value;
+    bytes[1] = (uint8_t) (value >> 8);
+}
+
+inline uint32_t readUint32(const uint8_t* bytes) {
+    return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (uint32_t) bytes[3] << 24;
+}
+
+inline void writeUint32(uint8_t* bytes, uint32_t value) {
+    for (int i=0; i<4; i++) {
+        bytes[i] = (uint8_t) (value >> 8*i);
+    }
+}
+
+#endif
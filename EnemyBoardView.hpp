@@ -0,0 +1,51 @@
+#ifndef ENEMYBOARDVIEW_HPP
+#define ENEMYBOARDVIEW_HPP
+#include <string>
+#include <vector>
+#include "Board.hpp"
+#include "Bitboard.hpp"
+
+using namespace std;
+
+// What a player is allowed to see of the enemy's board: where it attacked and which of those were hits.
+// Either a view of the enemy's actual board, or of the planes kept by a player that only knows the results
+// of its own attacks (like a bot in another process). It holds no copies, so it must not outlive what it views.
+class EnemyBoardView {
+    private:
+        Board* board;
+        int size, shipsLeft;
+        const Bitboard* attackedPlane, * hitPlane;
+
+    public:
+        EnemyBoardView(Board* board) : board(board), size(board->GetSize()), shipsLeft(board->GetShipsLeft()),
+            attackedPlane(&board->GetAttackedPlane()), hitPlane(&board->GetHitPlane()) {}
+        EnemyBoardView(int size, int shipsLeft, const Bitboard& attackedPlane, const Bitboard& hitPlane) :
+            board(NULL), size(size), shipsLeft(shipsLeft), attackedPlane(&attackedPlane), hitPlane(&hitPlane) {}
+
+        int GetSize() const {return size;}
+        // Amount of ships left when the view was made.
+        int GetShipsLeft() const {return shipsLeft;}
+        string GetPlayerName() const {return board ? board->GetPlayerName() : "";}
+        const Bitboard& GetAttackedPlane() const {return *attackedPlane;}
+        const Bitboard& GetHitPlane() const {return *hitPlane;}
+        bool HasBeenAttacked(int index) const {return attackedPlane->Test(index);}
+        // Sets `sizes` to the sizes of the ships left (see `Board::GetRemainingShipSizes`).
+        // Returns 'false' if they are not known because this is not a view of an actual board.
+        bool GetRemainingShipSizes(vector<int>& sizes) const {
+            if (!board) {
+                return false;
+            }
+            board->GetRemainingShipSizes(sizes);
+            return true;
+        }
+        // Sets `sizes` to the sizes of the ships sunk so far, like `GetRemainingShipSizes`.
+        bool GetSunkShipSizes(vector<int>& sizes) const {
+            if (!board) {
+                return false;
+            }
+            board->GetSunkShipSizes(sizes);
+            return true;
+        }
+};
+
+#endif
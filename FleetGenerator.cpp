@@ -0,0 +1,167 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <algorithm>
+#include "FleetGenerator.hpp"
+#include "Board.hpp"
+#include "Bitboard.hpp"
+#include "PlacementMasks.hpp"
+#include "Random.hpp"
+
+using namespace std;
+
+// Fleets that fail this many times in a row are counted and picked by index instead.
+const int maxIndependentAttempts = 1000;
+// Counting stops beyond this many layouts. There are then so many layouts that retrying usually finds one.
+const long long maxCountedLayouts = 10000000;
+// Attempts for a fleet with more layouts than are counted, before one of the counted ones is picked instead.
+const int maxUncountedAttempts = 100000;
+// Placements counting may try in total, so that it stays bounded for fleets that barely fit or do not fit at all.
+const long long maxCountingSteps = 100000000;
+
+FleetGenerator::FleetGenerator(int boardSize, vector<int> shipSizes) {
+    this->boardSize = boardSize;
+    this->words = Bitboard::GetWordCount(boardSize*boardSize);
+    this->shipSizes = shipSizes;
+    this->layoutCount = -1;
+    this->countedAll = false;
+    this->countingSteps = 0;
+    this->placements.assign(shipSizes.size(), 0);
+    this->occupied.assign(words, 0);
+
+    // One table per distinct ship size. A ship of size 1 has the same horizontal and vertical placements,
+    // which should only be counted once.
+    for (int shipSize: shipSizes) {
+        int tableIndex = -1;
+        for (size_t t=0; t<tables.size(); t++) {
+            if (tables[t].shipSize == shipSize) tableIndex = t;
+        }
+        if (tableIndex < 0) {
+            PlacementTable table;
+            table.shipSize = shipSize;
+            table.count = 0;
+            for (int step: {1, boardSize}) {
+                if (step == boardSize && shipSize == 1) break;
+                for (int y=0; y<boardSize; y++) {
+                    for (int x=0; x<boardSize; x++) {
+                        bool horizontal = step == 1;
+                        if ((horizontal ? x : y) + shipSize > boardSize) continue;
+                        table.masks.resize(table.masks.size() + words, 0);
+                        uint64_t* mask = &table.masks[table.count*words];
+                        bool legal;
+                        const uint64_t* tableMask = getPlacementMask(boardSize, shipSize, x + y*boardSize, horizontal ? 3 : 1, legal);
+                        for (int i=0; i<shipSize; i++) {
+                            int posIndex = x + y*boardSize + i*step;
+                            table.positions.push_back(posIndex);
+                            if (tableMask == NULL) mask[posIndex >> 6] |= uint64_t(1) << (posIndex & 63);
+                        }
+                        if (tableMask != NULL) copy(tableMask, tableMask + words, mask);
+                        table.count++;
+                    }
+                }
+            }
+            tableIndex = tables.size();
+            tables.push_back(table);
+        }
+        shipTables.push_back(tableIndex);
+    }
+};
+FleetGenerator::~FleetGenerator() {};
+
+bool FleetGenerator::Fits(const uint64_t* mask) {
+    for (int w=0; w<words; w++) {
+        if (occupied[w] & mask[w]) return false;
+    }
+    return true;
+}
+
+void FleetGenerator::Toggle(const uint64_t* mask) {
+    for (int w=0; w<words; w++) {
+        occupied[w] ^= mask[w];
+    }
+}
+
+// Gives every ship a uniformly random placement, and gives up as soon as two ships overlap.
+bool FleetGenerator::TryIndependentPlacements(Random& random) {
+    fill(occupied.begin(), occupied.end(), 0);
+    for (size_t ship=0; ship<shipSizes.size(); ship++) {
+        int count = tables[shipTables[ship]].count;
+        if (count == 0) return false;
+        placements[ship] = random.NextBelow(count);
+        const uint64_t* mask = GetMask(ship, placements[ship]);
+        if (!Fits(mask)) return false;
+        Toggle(mask);
+    }
+    return true;
+}
+
+// Counts the layouts of the ships from `ship` onwards on the positions that are still free.
+// Stops counting once `limit` is passed or `countingSteps` runs out.
+long long FleetGenerator::CountLayouts(int ship, long long limit) {
+    if (ship == (int) shipSizes.size()) return 1;
+    long long count = 0;
+    for (int p=0; p<tables[shipTables[ship]].count && count <= limit && countingSteps > 0; p++) {
+        countingSteps--;
+        const uint64_t* mask = GetMask(ship, p);
+        if (Fits(mask)) {
+            Toggle(mask);
+            count += CountLayouts(ship+1, limit - count);
+            Toggle(mask);
+        }
+    }
+    return count;
+}
+
+// Finds the layout with the given index in the order `CountLayouts` counts them, and stores it in `placements`.
+bool FleetGenerator::FindLayout(int ship, long long& index) {
+    if (ship == (int) shipSizes.size()) return index-- == 0;
+    for (int p=0; p<tables[shipTables[ship]].count; p++) {
+        const uint64_t* mask = GetMask(ship, p);
+        if (Fits(mask)) {
+            Toggle(mask);
+            placements[ship] = p;
+            bool found = FindLayout(ship+1, index);
+            Toggle(mask);
+            if (found) return true;
+        }
+    }
+    return false;
+}
+
+void FleetGenerator::Generate(Random& random) {
+    int attempts = layoutCount >= 0 && !countedAll ? maxUncountedAttempts : maxIndependentAttempts;
+    for (int attempt=0; attempt<attempts; attempt++) {
+        if (TryIndependentPlacements(random)) return;
+    }
+    if (layoutCount < 0) {
+        fill(occupied.begin(), occupied.end(), 0);
+        countingSteps = maxCountingSteps;
+        layoutCount = CountLayouts(0, maxCountedLayouts);
+        countedAll = layoutCount <= maxCountedLayouts && countingSteps > 0;
+    }
+    if (layoutCount == 0) {
+        // Also when counting ran out of steps before finding a layout: the fleet then fits hardly, if at all.
+        throw "The ships do not fit on the board together.";
+    }
+    if (!countedAll && attempts < maxUncountedAttempts) {
+        // Too many layouts to pick by index, keep retrying instead.
+        for (int attempt=0; attempt<maxUncountedAttempts; attempt++) {
+            if (TryIndependentPlacements(random)) return;
+        }
+    }
+    // Picking a layout by index takes at most as long as counting them did.
+    long long index = random.NextBelow((uint32_t) min(layoutCount, maxCountedLayouts));
+    fill(occupied.begin(), occupied.end(), 0);
+    FindLayout(0, index);
+}
+
+void FleetGenerator::PlaceFleet(Board& board, vector<int>& shipPositions) {
+    for (size_t ship=0; ship<shipSizes.size(); ship++) {
+        const int* positions = GetShipPositions(ship);
+        shipPositions.assign(positions, positions + shipSizes[ship]);
+        board.PlaceShip(shipPositions, shipSizes[ship]);
+    }
+}
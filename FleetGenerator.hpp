@@ -0,0 +1,74 @@
+#ifndef FLEETGENERATOR_HPP
+#define FLEETGENERATOR_HPP
+#include <vector>
+#include <cstdint>
+#include "Board.hpp"
+#include "Random.hpp"
+
+using namespace std;
+
+// Picks random fleet layouts: a placement for every ship such that no two ships overlap.
+// Every legal layout is exactly equally likely, for any board size and list of ships, except in the rare case below.
+//
+// Every ship independently gets a uniformly random placement out of all its placements, and the
+// whole fleet is retried on an overlap. Each legal layout then has the same chance, unlike placing
+// ships one by one and retrying only the ship that overlaps. When a fleet hardly fits and retries
+// keep failing, the generator instead counts all layouts once and picks one of them by index.
+//
+// Counting stops at ten million layouts, or after a hundred million placements tried. Beyond that the generator
+// goes back to retrying, with a limit: if even that keeps failing, it picks one of the layouts counted so far.
+// That is not uniform, but it keeps `Generate` bounded in time. Only fleets that barely fit on a large board get
+// that far. A fleet for which counting finds no layout at all is refused, even if it might just fit.
+class FleetGenerator {
+    private:
+        // All placements of a ship of one size, as position lists and as bit masks over the board.
+        struct PlacementTable {
+            int shipSize;
+            int count;
+            vector<int> positions;
+            vector<uint64_t> masks;
+        };
+
+        int boardSize, words;
+        vector<int> shipSizes;
+        vector<PlacementTable> tables;
+        // Per ship, the index of the table with its placements.
+        vector<int> shipTables;
+        // Per ship, the index of the chosen placement.
+        vector<int> placements;
+        vector<uint64_t> occupied;
+        // Amount of legal layouts, or -1 if not counted (yet). Only the layouts counted so far if not `countedAll`.
+        long long layoutCount;
+        bool countedAll;
+        // Placements counting may still try.
+        long long countingSteps;
+
+        const uint64_t* GetMask(int ship, int placement) {
+            PlacementTable& table = tables[shipTables[ship]];
+            return &table.masks[placement*words];
+        }
+        bool Fits(const uint64_t* mask);
+        void Toggle(const uint64_t* mask);
+        bool TryIndependentPlacements(Random& random);
+        long long CountLayouts(int ship, long long limit);
+        bool FindLayout(int ship, long long& index);
+
+    public:
+        FleetGenerator(int boardSize, vector<int> shipSizes);
+        ~FleetGenerator();
+
+        int GetBoardSize() {return boardSize;}
+        const vector<int>& GetShipSizes() {return shipSizes;}
+
+        // Picks a new layout. Throws if the ships can not fit on the board together.
+        void Generate(Random& random);
+        // Positions of a ship in the last layout picked.
+        const int* GetShipPositions(int ship) {
+            PlacementTable& table = tables[shipTables[ship]];
+            return &table.positions[placements[ship]*table.shipSize];
+        }
+        // Places the ships of the last layout picked on a board.
+        void PlaceFleet(Board& board, vector<int>& shipPositions);
+};
+
+#endif
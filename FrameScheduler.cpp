@@ -0,0 +1,72 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include "FrameScheduler.hpp"
+
+using namespace std;
+
+FrameScheduler::FrameScheduler(bool noDelays) : skipped(0) {
+    this->nextSequence = 0;
+    this->noDelays = noDelays;
+};
+FrameScheduler::~FrameScheduler() {};
+
+// Orders the timer heap so the earliest timer is on top. Timers due at the same time run in the order they were added.
+bool FrameScheduler::RunsLater(const Timer& a, const Timer& b) {
+    if (a.due != b.due) {
+        return a.due > b.due;
+    }
+    return a.sequence > b.sequence;
+}
+
+void FrameScheduler::SleepUntil(Clock::time_point time) {
+    Clock::time_point now = Now();
+    if (time <= now) {
+        return;
+    }
+    if (noDelays) {
+        skipped += time - now;
+    } else {
+        this_thread::sleep_until(time - skipped);
+    }
+}
+
+void FrameScheduler::After(int milliseconds, function<void()> callback) {
+    timers.push_back(Timer{Now() + chrono::milliseconds(milliseconds), nextSequence++, callback});
+    push_heap(timers.begin(), timers.end(), RunsLater);
+}
+
+void FrameScheduler::RunDue() {
+    Clock::time_point now = Now();
+    while (!timers.empty() && timers.front().due <= now) {
+        pop_heap(timers.begin(), timers.end(), RunsLater);
+        Timer timer = timers.back();
+        timers.pop_back();
+        // The callback may add new timers.
+        timer.callback();
+    }
+}
+
+void FrameScheduler::Wait(int milliseconds) {
+    Clock::time_point end = Now() + chrono::milliseconds(milliseconds);
+    RunDue();
+    while (!timers.empty() && timers.front().due <= end) {
+        SleepUntil(timers.front().due);
+        RunDue();
+    }
+    SleepUntil(end);
+}
+
+void FrameScheduler::RunUntilIdle() {
+    RunDue();
+    while (!timers.empty()) {
+        SleepUntil(timers.front().due);
+        RunDue();
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef FRAMESCHEDULER_HPP
+#define FRAMESCHEDULER_HPP
+#include <vector>
+#include <chrono>
+#include <functional>
+
+using namespace std;
+
+// Runs timed callbacks, such as the frames of an animation, on a monotonic clock.
+// Waiting sleeps until the next callback is due instead of spinning on the clock, and a game loop
+// can call `RunDue` now and then to let animations progress without blocking on them.
+// In 'no delays' mode the clock jumps ahead instead of sleeping: callbacks still run in order, but immediately.
+class FrameScheduler {
+    public:
+        typedef chrono::steady_clock Clock;
+
+    private:
+        struct Timer {
+            Clock::time_point due;
+            long sequence;
+            function<void()> callback;
+        };
+
+        vector<Timer> timers;
+        long nextSequence;
+        bool noDelays;
+        // How far the clock jumped ahead in 'no delays' mode.
+        Clock::duration skipped;
+
+        static bool RunsLater(const Timer& a, const Timer& b);
+        void SleepUntil(Clock::time_point time);
+
+    public:
+        FrameScheduler(bool noDelays = false);
+        ~FrameScheduler();
+
+        void SetNoDelays(bool noDelays) {this->noDelays = noDelays;}
+        bool HasNoDelays() {return noDelays;}
+        bool HasPending() {return !timers.empty();}
+        Clock::time_point Now() {return Clock::now() + skipped;}
+
+        // Runs `callback` once the given amount of milliseconds have passed.
+        void After(int milliseconds, function<void()> callback);
+        // Runs the callbacks that are due, without waiting.
+        void RunDue();
+        // Waits the given amount of milliseconds, running callbacks as they become due.
+        void Wait(int milliseconds);
+        // Waits until every callback has run.
+        void RunUntilIdle();
+};
+
+#endif
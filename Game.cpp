@@ -0,0 +1,159 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <future>
+#include <algorithm>
+#include "Game.hpp"
+#include "Board.hpp"
+#include "GameRules.hpp"
+#include "Player.hpp"
+#include "EnemyBoardView.hpp"
+#include "GameRecord.hpp"
+#include "Snapshot.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+/*******************************************************************
+                GAME CLASS
+********************************************************************/
+
+// A battleship game. Should be either a 'ClassicGame' or 'SalvoGame' derived class.
+// This class has methods and attributes inherited by those derived classes.
+Game::Game(int boardSize) {
+    this->boardSize = boardSize;
+    this->boardPlayerOne = NULL;
+    this->boardPlayerTwo = NULL;
+    this->finished = false;
+    this->forfeited = false;
+    this->playerTwoTurn = false;
+    this->recorder = NULL;
+    this->players[0] = this->players[1] = NULL;
+    this->fleetPlaced[0] = this->fleetPlaced[1] = false;
+    this->illegalAttacks = 0;
+}
+Game::~Game() {}
+
+void Game::SetBoardPlayerOne(Board* boardPlayerOne){this->boardPlayerOne = boardPlayerOne;}
+void Game::SetBoardPlayerTwo(Board* boardPlayerTwo){this->boardPlayerTwo = boardPlayerTwo;}
+vector<AttackResult> Game::GetTurnResult() {return turnResult;}
+void Game::AddTurnResult(AttackResult attackResult){this->turnResult.push_back (attackResult);}
+bool Game::HasFinished(){return finished;}
+bool Game::HasForfeited(){return forfeited;}
+bool Game::IsPlayerTwoTurn(){return playerTwoTurn;}
+void Game::EndTurn(){this->playerTwoTurn = !playerTwoTurn;}
+void Game::SetRecorder(GameRecorder* recorder){this->recorder = recorder;}
+void Game::SetPlayers(Player* playerOne, Player* playerTwo){this->players[0] = playerOne; this->players[1] = playerTwo;}
+
+// Adds an attack on `enemyBoard` to the game record, if the game is being recorded.
+void Game::RecordAttack(Board* enemyBoard, int posIndex, AttackResult attackResult) {
+    if (recorder) {
+        recorder->AddShot(enemyBoard == boardPlayerOne ? 1 : 0, posIndex, attackResult);
+    }
+}
+
+void Game::SaveSnapshot(ostream& out) {
+    GameSnapshotHeader header = {(uint8_t) GetRuleset(), finished, playerTwoTurn, 0, boardSize};
+    writeGameSnapshotHeader(out, header);
+    boardPlayerOne->SaveSnapshot(out);
+    boardPlayerTwo->SaveSnapshot(out);
+}
+
+void Game::LoadSnapshot(const GameSnapshotHeader& header, istream& in) {
+    if (header.ruleset != GetRuleset() || header.boardSize != boardSize) {
+        throw "The snapshot is not of this kind of game.";
+    }
+    boardPlayerOne->LoadSnapshot(in);
+    boardPlayerTwo->LoadSnapshot(in);
+    this->finished = header.finished;
+    this->forfeited = false;
+    this->playerTwoTurn = header.playerTwoTurn;
+    this->turnResult.clear();
+}
+
+// Both players are asked at once, so a player that answers later does not hold up the other one.
+bool Game::PlaceShips(const vector<int>& shipSizes) {
+    Board* boards[2] = {boardPlayerOne, boardPlayerTwo};
+    for (int player=0; player<2; player++) {
+        if (!fleetPlaced[player] && !pendingPlacements[player].valid()) {
+            pendingPlacements[player] = players[player]->PlaceShips(*boards[player], shipSizes);
+        }
+        if (!fleetPlaced[player] && isReady(pendingPlacements[player])) {
+            pendingPlacements[player].get();
+            fleetPlaced[player] = true;
+        }
+    }
+    return fleetPlaced[0] && fleetPlaced[1];
+}
+
+bool Game::Attack() {
+    Board* ownBoard = playerTwoTurn ? boardPlayerTwo : boardPlayerOne;
+    Board* enemyBoard = playerTwoTurn ? boardPlayerOne : boardPlayerTwo;
+    Player* player = players[playerTwoTurn];
+    int count = GetShotsPerTurn(ownBoard, enemyBoard);
+    while (true) {
+        if (!pendingAttack.valid()) {
+            pendingAttack = player->ChooseAttack(*ownBoard, EnemyBoardView(enemyBoard), count);
+        }
+        if (!isReady(pendingAttack)) {
+            return false;
+        }
+        attackPositions = pendingAttack.get();
+        attackResults.resize(attackPositions.size());
+        if ((int) attackPositions.size() != count) {
+            METRICS_COUNT(invalidAttacksCounter, 1);
+        } else if (enemyBoard->GetAttackedSalvo(attackPositions.data(), count, attackResults.data())) {
+            break;
+        }
+        // Like in a headless game, an illegal attack is asked for again, up to a point.
+        if (++illegalAttacks == maxIllegalAttacks) {
+            this->illegalAttacks = 0;
+            this->finished = true;
+            this->forfeited = true;
+            METRICS_COUNT(gamesCounter, 1);
+            return true;
+        }
+    }
+    this->illegalAttacks = 0;
+    for (int i=0; i<count; i++) {
+        this->RecordAttack(enemyBoard, attackPositions[i], attackResults[i]);
+        this->AddTurnResult(attackResults[i]);
+        player->ReceiveAttackResult(attackPositions[i], attackResults[i]);
+        if (attackResults[i] == won) {
+            this->finished = true;
+            METRICS_COUNT(gamesCounter, 1);
+        }
+    }
+    METRICS_COUNT(turnsCounter, 1);
+    return true;
+}
+
+void Game::WaitForPlayer() {
+    if (pendingAttack.valid()) {
+        pendingAttack.wait();
+        return;
+    }
+    for (int player=0; player<2; player++) {
+        if (pendingPlacements[player].valid()) {
+            pendingPlacements[player].wait();
+            return;
+        }
+    }
+}
+
+SalvoGame::SalvoGame(int boardSize) : Game(boardSize) {};
+SalvoGame::~SalvoGame() {};
+
+int SalvoGame::GetShotsPerTurn(Board* ownBoard, Board* enemyBoard) {
+    return SalvoRules::GetShotsPerTurn(*ownBoard, *enemyBoard);
+}
+
+ClassicGame::ClassicGame(int boardSize) : Game(boardSize) {};
+ClassicGame::~ClassicGame(){};
+
+int ClassicGame::GetShotsPerTurn(Board* ownBoard, Board* enemyBoard) {
+    return ClassicRules::GetShotsPerTurn(*ownBoard, *enemyBoard);
+}
@@ -3,14 +3,19 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <future>
 #include "Board.hpp"
 #include "Position.hpp"
 #include "AttackResult.hpp"
+#include "Ruleset.hpp"
+#include "Snapshot.hpp"
 
 
 
 using namespace std;
 
+class GameRecorder;
+class Player;
 
 class Game {
     protected:
@@ -18,12 +23,24 @@ class Game {
         int boardSize;
         vector<AttackResult> turnResult;
         bool finished;
+        bool forfeited;
+        bool playerTwoTurn;
+        GameRecorder* recorder;
+        Player* players[2];
+        // Answers the players have not given yet.
+        future<void> pendingPlacements[2];
+        bool fleetPlaced[2];
+        future<vector<int>> pendingAttack;
+        vector<int> attackPositions;
+        vector<AttackResult> attackResults;
+        // Illegal attacks the player whose turn it is made this turn.
+        int illegalAttacks;
         void PrintAttackResult(AttackResult attackResult);
-        void AttackHelper(Board*ownBoard, Board* enemyBoard);
+        void RecordAttack(Board* enemyBoard, int posIndex, AttackResult attackResult);
 
     public:
         Game(int boardSize);
-        ~Game();
+        virtual ~Game();
 
         Board* GetBoardPlayerOne();
         void SetBoardPlayerOne(Board* boardPlayerOne);
@@ -34,12 +51,37 @@ class Game {
         void SetTurnResult(vector<AttackResult> turnResult);
         void AddTurnResult(AttackResult attackResult);
         bool HasFinished();
+        // Whether the game ended because the player whose turn it was forfeited it, see `maxIllegalAttacks`.
+        bool HasForfeited();
+        bool IsPlayerTwoTurn();
+        // Gives the turn to the other player.
+        void EndTurn();
+        virtual Ruleset GetRuleset() = 0;
+        // Records every attack from now on with `recorder`, or stops recording if it is NULL.
+        void SetRecorder(GameRecorder* recorder);
 
-        virtual void Attack(Board* ownBoard, Board* enemyBoard){};
-        
-        void DisplayTurnResult(Board* ownBoard, Board* enemyBoard);
-        void PlaceShips(Board board);
+        // Sets who plays on each board (see `Player.hpp`).
+        void SetPlayers(Player* playerOne, Player* playerTwo);
+        // Amount of positions the player of `ownBoard` attacks in one turn, see `GameRules.hpp`.
+        virtual int GetShotsPerTurn(Board* ownBoard, Board* enemyBoard) = 0;
+
+        // Asks both players to place their fleet. Returns 'true' once both fleets are placed, or 'false' without
+        // waiting while a player has not answered yet. Should then be called again, for example after `WaitForPlayer`.
+        bool PlaceShips(const vector<int>& shipSizes);
+        // Asks the player whose turn it is for the positions to attack and attacks them. Returns 'true' once the
+        // turn is over, or 'false' like `PlaceShips` while the player has not answered yet.
+        // An illegal attack is asked for again, until the player forfeits the game after `maxIllegalAttacks`.
+        bool Attack();
+        // Waits until a player answers the request that `PlaceShips` or `Attack` is waiting for.
+        void WaitForPlayer();
+
+        void DisplayTurnResult(Board* ownBoard, Board* enemyBoard, bool belowBoards);
 
+        // Saves both boards and the state of the game as a snapshot (see `Snapshot.hpp`).
+        void SaveSnapshot(ostream& out);
+        // Restores a game saved with `SaveSnapshot`, of which `header` has already been read from `in`.
+        // The boards must be set and have the size of the snapshot. Throws if the snapshot does not fit this game.
+        void LoadSnapshot(const GameSnapshotHeader& header, istream& in);
         
       
 };
@@ -48,7 +90,8 @@ class ClassicGame: public Game {
     public:
         ClassicGame(int boardSize);
         ~ClassicGame();
-        void Attack(Board* ownBoard, Board* enemyBoard);
+        Ruleset GetRuleset() {return classic;}
+        int GetShotsPerTurn(Board* ownBoard, Board* enemyBoard);
 
 };  
 
@@ -56,7 +99,8 @@ class SalvoGame: public Game {
     public:
         SalvoGame(int boardSize);
         ~SalvoGame();
-        void Attack(Board* ownBoard, Board* enemyBoard);
+        Ruleset GetRuleset() {return salvo;}
+        int GetShotsPerTurn(Board* ownBoard, Board* enemyBoard);
 
 };
 
@@ -0,0 +1,526 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <climits>
+#include "GameRecord.hpp"
+#include "ByteOrder.hpp"
+#include "Board.hpp"
+#include "Ship.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+const char fileHeader[8] = {'B', 'S', 'G', 'R', 1, 0, 0, 0};
+// Bytes of a game before its ships: the ruleset, board size, winner and ship count, then the shot count.
+const int gameHeaderSize = 8;
+// Games on boards with more positions than this (16x16) are stored with a seek index.
+const int seekIndexMinPositions = 256;
+
+// Returns the amount of bits needed to store every position of a board.
+int getPositionBits(int boardSize) {
+    int bits = 1;
+    while ((1 << bits) < boardSize*boardSize) {
+        bits++;
+    }
+    return bits;
+}
+
+int getVarintLength(uint32_t value) {
+    int length = 1;
+    for (; value >= 0x80; value >>= 7) {
+        length++;
+    }
+    return length;
+}
+
+uint32_t zigzag(int32_t value) {
+    return (uint32_t) value << 1 ^ (uint32_t) (value >> 31);
+}
+
+// Reads shot `shot` of bit-packed shots.
+RecordedShot readPackedShot(const uint8_t* shots, int shot, int positionBits) {
+    int shotBits = positionBits + 3;
+    long firstBit = (long) shot * shotBits;
+    // A shot takes at most 19 bits, so it is spread over at most 4 bytes.
+    uint32_t bits = 0;
+    int byteCount = (firstBit % 8 + shotBits + 7) / 8;
+    for (int i=0; i<byteCount; i++) {
+        bits |= (uint32_t) shots[firstBit/8 + i] << 8*i;
+    }
+    bits >>= firstBit % 8;
+    return {(int) (bits & 1), (int) ((bits >> 1) & ((1u << positionBits) - 1)), (AttackResult) ((bits >> (positionBits + 1)) & 3)};
+}
+
+void writeGameRecordFileHeader(ostream& out) {
+    out.write(fileHeader, sizeof(fileHeader));
+}
+
+/*******************************************************************
+                GAME RECORDER CLASS
+********************************************************************/
+
+GameRecorder::GameRecorder() {
+    this->byteCount = 0;
+    this->gameStart = -1;
+    this->shotCount = 0;
+    this->positionBits = 1;
+    this->pendingBits = 0;
+    this->pendingBitCount = 0;
+    this->seekIndex = false;
+    this->keyframeInterval = 0;
+    this->seekFieldsStart = 0;
+};
+GameRecorder::~GameRecorder() {};
+
+uint8_t* GameRecorder::Append(int count) {
+    if (byteCount + count > bytes.size()) {
+        bytes.resize(max(2*bytes.size(), byteCount + count + 4096));
+    }
+    uint8_t* room = &bytes[byteCount];
+    byteCount += count;
+    return room;
+}
+
+// Writes the ships of a board, each one by its first position, size and orientation.
+// Only the positions in the ship plane are visited.
+void GameRecorder::WriteFleet(Board& board) {
+    seenShips.clear();
+    int boardSize = board.GetSize();
+    const Bitboard& shipPlane = board.GetShipPlane();
+    for (int w=0; w<shipPlane.GetWordCount(); w++) {
+        for (uint64_t word=shipPlane.GetWords()[w]; word; word &= word-1) {
+            int index = w*64 + lowestBit(word);
+            Ship* ship = board.GetShip(index);
+            if (find(seenShips.begin(), seenShips.end(), ship) != seenShips.end()) {
+                continue;
+            }
+            seenShips.push_back(ship);
+            bool vertical = ship->GetSize() > 1 && (index % boardSize == boardSize-1 || board.GetShip(index+1) != ship);
+            uint8_t* shipBytes = Append(3);
+            shipBytes[0] = (uint8_t) index;
+            shipBytes[1] = (uint8_t) (index >> 8);
+            shipBytes[2] = (uint8_t) (ship->GetSize() | (vertical ? 0x80 : 0));
+        }
+    }
+}
+
+void GameRecorder::WritePackedShot(int player, int position, AttackResult result) {
+    pendingBits |= (uint64_t) (player | position << 1 | (uint64_t) result << (positionBits + 1)) << pendingBitCount;
+    pendingBitCount += positionBits + 3;
+    // Whole words are moved to the buffer at once; the rest waits for the next shot or `FlushPackedShots`.
+    if (pendingBitCount >= 32) {
+        writeUint32(Append(4), (uint32_t) pendingBits);
+        pendingBits >>= 32;
+        pendingBitCount -= 32;
+    }
+}
+
+void GameRecorder::FlushPackedShots() {
+    for (; pendingBitCount > 0; pendingBitCount -= 8) {
+        *Append(1) = (uint8_t) pendingBits;
+        pendingBits >>= 8;
+    }
+    pendingBits = 0;
+    pendingBitCount = 0;
+}
+
+void GameRecorder::WriteVarint(uint32_t value) {
+    uint8_t* out = Append(5);
+    int length = 0;
+    for (; value >= 0x80; value >>= 7) {
+        out[length++] = (uint8_t) (value | 0x80);
+    }
+    out[length++] = (uint8_t) value;
+    byteCount -= 5 - length;
+}
+
+// Writes the shots of the current segment in whichever encoding takes fewer bytes.
+void GameRecorder::WriteSegment() {
+    int previousPositions[2] = {0, 0};
+    size_t varintBytes = 0;
+    for (size_t i=0; i<segmentShots.size(); i++) {
+        RecordedShot& shot = segmentShots[i];
+        varintBytes += getVarintLength(zigzag(shot.position - previousPositions[shot.player]) << 3 | shot.result << 1 | shot.player);
+        previousPositions[shot.player] = shot.position;
+    }
+    size_t packedBytes = (segmentShots.size() * (positionBits + 3) + 7) / 8;
+
+    bool packed = packedBytes < varintBytes;
+    *Append(1) = packed ? 1 : 0;
+    previousPositions[0] = previousPositions[1] = 0;
+    for (size_t i=0; i<segmentShots.size(); i++) {
+        RecordedShot& shot = segmentShots[i];
+        if (packed) {
+            WritePackedShot(shot.player, shot.position, shot.result);
+        } else {
+            WriteVarint(zigzag(shot.position - previousPositions[shot.player]) << 3 | shot.result << 1 | shot.player);
+            previousPositions[shot.player] = shot.position;
+        }
+    }
+    FlushPackedShots();
+    segmentShots.clear();
+}
+
+// Starts a new segment with the attacked positions of both boards.
+void GameRecorder::WriteKeyframe() {
+    segmentOffsets.push_back(byteCount - gameStart - 4);
+    for (int board=0; board<2; board++) {
+        for (size_t w=0; w<attacked[board].size(); w++) {
+            uint8_t* out = Append(8);
+            for (int i=0; i<8; i++) {
+                out[i] = (uint8_t) (attacked[board][w] >> 8*i);
+            }
+        }
+    }
+}
+
+void GameRecorder::BeginGame(Ruleset ruleset, Board& boardPlayerOne, Board& boardPlayerTwo) {
+    if (gameStart >= 0) {
+        EndGame(-1);
+    }
+    gameStart = byteCount;
+    shotCount = 0;
+    positionBits = getPositionBits(boardPlayerOne.GetSize());
+    pendingBits = 0;
+    pendingBitCount = 0;
+    int positionCount = boardPlayerOne.GetSize()*boardPlayerOne.GetSize();
+    seekIndex = positionCount > seekIndexMinPositions;
+
+    uint8_t* header = Append(4 + gameHeaderSize) + 4;
+    header[0] = (uint8_t) (ruleset | (seekIndex ? 0x80 : 0));
+    header[1] = (uint8_t) boardPlayerOne.GetSize();
+    size_t shipsStart = byteCount;
+    WriteFleet(boardPlayerOne);
+    bytes[gameStart + 4 + 3] = (uint8_t) ((byteCount - shipsStart) / 3);
+    WriteFleet(boardPlayerTwo);
+
+    if (seekIndex) {
+        // A keyframe takes about as many bytes as the shots of a segment.
+        keyframeInterval = max(1024, positionCount/4);
+        seekFieldsStart = byteCount;
+        writeUint32(Append(8), keyframeInterval);
+        segmentShots.clear();
+        segmentOffsets.clear();
+        segmentOffsets.push_back(byteCount - gameStart - 4);
+        for (int board=0; board<2; board++) {
+            attacked[board].assign(Bitboard::GetWordCount(positionCount), 0);
+        }
+    }
+}
+
+void GameRecorder::AddShot(int player, int position, AttackResult result) {
+    if (seekIndex) {
+        if (segmentShots.size() == (size_t) keyframeInterval) {
+            WriteSegment();
+            WriteKeyframe();
+        }
+        segmentShots.push_back({player, position, result});
+        // The shots of a player attack the board of the other player.
+        attacked[1-player][position >> 6] |= uint64_t(1) << (position & 63);
+    } else {
+        WritePackedShot(player, position, result);
+    }
+    shotCount++;
+}
+
+void GameRecorder::EndGame(int winner) {
+    if (gameStart < 0) {
+        return;
+    }
+    if (seekIndex) {
+        WriteSegment();
+        writeUint32(&bytes[seekFieldsStart + 4], byteCount - gameStart - 4);
+        for (size_t i=0; i<segmentOffsets.size(); i++) {
+            writeUint32(Append(4), segmentOffsets[i]);
+        }
+    } else {
+        FlushPackedShots();
+    }
+    writeUint32(&bytes[gameStart], byteCount - gameStart - 4);
+    bytes[gameStart + 4 + 2] = winner < 0 ? 255 : (uint8_t) winner;
+    writeUint32(&bytes[gameStart + 4 + 4], shotCount);
+    gameStart = -1;
+}
+
+void GameRecorder::Flush(ostream& out) {
+    size_t finished = gameStart < 0 ? byteCount : gameStart;
+    out.write((const char*) bytes.data(), finished);
+    copy(bytes.begin() + finished, bytes.begin() + byteCount, bytes.begin());
+    byteCount -= finished;
+    // The game being recorded moved to the front, and so did the fields that are filled in when it ends.
+    if (gameStart >= 0) {
+        gameStart = 0;
+        if (seekIndex) {
+            seekFieldsStart -= finished;
+        }
+    }
+}
+
+/*******************************************************************
+                RECORDED GAME CLASS
+********************************************************************/
+
+RecordedGame::RecordedGame() : data(NULL), positionBits(1) {};
+RecordedGame::RecordedGame(const uint8_t* data) : data(data), positionBits(getPositionBits(data[1])) {};
+
+int RecordedGame::GetShotCount() const {
+    return readUint32(data + 4);
+}
+
+RecordedShip RecordedGame::GetShip(int player, int ship) const {
+    const uint8_t* bytes = data + gameHeaderSize + 3*(player*GetShipCount() + ship);
+    return {bytes[0] | bytes[1] << 8, (bytes[2] & 0x80) != 0, bytes[2] & 0x7f};
+}
+
+const uint8_t* RecordedGame::GetShotData() const {
+    return data + gameHeaderSize + 3*2*GetShipCount() + (HasSeekIndex() ? 8 : 0);
+}
+
+int RecordedGame::GetKeyframeInterval() const {
+    return readUint32(data + gameHeaderSize + 3*2*GetShipCount());
+}
+
+int RecordedGame::GetSegmentCount() const {
+    return GetShotCount() == 0 ? 1 : (GetShotCount() - 1) / GetKeyframeInterval() + 1;
+}
+
+const uint8_t* RecordedGame::GetSegment(int segment) const {
+    const uint8_t* index = data + readUint32(data + gameHeaderSize + 3*2*GetShipCount() + 4);
+    return data + readUint32(index + 4*segment);
+}
+
+// A segment ends where the next one starts, and the last one where the index starts.
+const uint8_t* RecordedGame::GetSegmentEnd(int segment) const {
+    if (segment+1 < GetSegmentCount()) {
+        return GetSegment(segment+1);
+    }
+    return data + readUint32(data + gameHeaderSize + 3*2*GetShipCount() + 4);
+}
+
+// Checks the header and the layout of the bytes, so that reading the game stays within them. The shots themselves
+// are checked by `RecordedGameCursor::Next`.
+bool RecordedGame::FitsIn(uint32_t length) const {
+    if (length < gameHeaderSize || GetRuleset() > salvo || GetBoardSize() < 1 || GetWinner() > 1) {
+        return false;
+    }
+    uint64_t shotCount = readUint32(data + 4);
+    uint64_t shotStart = gameHeaderSize + 3*2*GetShipCount() + (HasSeekIndex() ? 8 : 0);
+    uint64_t shotBits = positionBits + 3;
+    if (shotStart > length || shotCount > INT_MAX) {
+        return false;
+    }
+    if (!HasSeekIndex()) {
+        return shotStart + (shotCount*shotBits + 7) / 8 <= length;
+    }
+    uint64_t interval = readUint32(data + shotStart - 8), indexOffset = readUint32(data + shotStart - 4);
+    if (interval == 0 || indexOffset < shotStart) {
+        return false;
+    }
+    uint64_t segmentCount = shotCount == 0 ? 1 : (shotCount - 1) / interval + 1;
+    if (indexOffset + 4*segmentCount > length) {
+        return false;
+    }
+    uint64_t keyframeBytes = 2*8*Bitboard::GetWordCount(GetBoardSize()*GetBoardSize());
+    for (uint64_t segment=0; segment<segmentCount; segment++) {
+        uint64_t start = readUint32(data + indexOffset + 4*segment);
+        uint64_t end = segment+1 < segmentCount ? readUint32(data + indexOffset + 4*(segment+1)) : indexOffset;
+        // The keyframe (but for the first segment) and the byte that tells how the shots are stored.
+        uint64_t headerBytes = (segment > 0 ? keyframeBytes : 0) + 1;
+        if ((segment == 0 && start != shotStart) || start + headerBytes > end || end > indexOffset) {
+            return false;
+        }
+        // A varint takes at least one byte per shot.
+        uint64_t shots = min(interval, shotCount - segment*interval);
+        uint64_t shotBytes = data[start + headerBytes - 1] == 1 ? (shots*shotBits + 7) / 8 : shots;
+        if (start + headerBytes + shotBytes > end) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RecordedShot RecordedGame::GetShot(int shot) const {
+    if (HasSeekIndex()) {
+        RecordedShot recordedShot;
+        RecordedGameCursor(*this, shot).Next(recordedShot);
+        return recordedShot;
+    }
+    return readPackedShot(GetShotData(), shot, positionBits);
+}
+
+/*******************************************************************
+                RECORDED GAME CURSOR CLASS
+********************************************************************/
+
+RecordedGameCursor::RecordedGameCursor(const RecordedGame& game, int shot) {
+    this->game = game;
+    this->shot = 0;
+    this->keyframeInterval = 0;
+    this->stream = NULL;
+    this->segmentEnd = NULL;
+    this->packedSegment = false;
+    this->previousPositions[0] = this->previousPositions[1] = 0;
+    int wordCount = Bitboard::GetWordCount(game.GetBoardSize()*game.GetBoardSize());
+    for (int board=0; board<2; board++) {
+        attacked[board].assign(wordCount, 0);
+    }
+
+    // Games with a seek index start at the segment of `shot`, or the last one if `shot` is past the end.
+    if (game.HasSeekIndex()) {
+        this->keyframeInterval = game.GetKeyframeInterval();
+        int segment = max(0, min(shot, game.GetShotCount() - 1)) / keyframeInterval;
+        this->stream = game.GetSegment(segment);
+        this->segmentEnd = game.GetSegmentEnd(segment);
+        this->shot = segment*keyframeInterval;
+        if (segment > 0) {
+            // `Next` moves past the keyframe, like it does when it reaches a segment.
+            const uint8_t* words = stream;
+            for (int board=0; board<2; board++) {
+                for (int w=0; w<wordCount; w++, words+=8) {
+                    attacked[board][w] = readUint32(words) | (uint64_t) readUint32(words + 4) << 32;
+                }
+            }
+        } else {
+            this->packedSegment = *stream == 1;
+            this->stream++;
+        }
+    }
+    RecordedShot skipped;
+    while (this->shot < shot && Next(skipped)) {}
+};
+
+bool RecordedGameCursor::Next(RecordedShot& recordedShot) {
+    if (shot >= game.GetShotCount()) {
+        return false;
+    }
+    if (stream == NULL) {
+        recordedShot = game.GetShot(shot);
+    } else {
+        if (shot > 0 && shot % keyframeInterval == 0) {
+            // Move on to the next segment, past its keyframe.
+            int segment = shot / keyframeInterval;
+            stream = game.GetSegment(segment) + 2*8*attacked[0].size();
+            segmentEnd = game.GetSegmentEnd(segment);
+            packedSegment = *stream == 1;
+            stream++;
+            previousPositions[0] = previousPositions[1] = 0;
+        }
+        if (packedSegment) {
+            recordedShot = readPackedShot(stream, shot % keyframeInterval, game.positionBits);
+        } else {
+            uint32_t value = 0;
+            for (int shift=0; ; shift+=7) {
+                if (stream == segmentEnd || shift > 28) {
+                    throw "The game record file holds a damaged game.";
+                }
+                uint8_t byte = *stream++;
+                value |= (uint32_t) (byte & 0x7f) << shift;
+                if (byte < 0x80) break;
+            }
+            int player = value & 1;
+            uint32_t delta = value >> 3;
+            recordedShot = {player, previousPositions[player] + ((int32_t) (delta >> 1) ^ -(int32_t) (delta & 1)), (AttackResult) ((value >> 1) & 3)};
+            previousPositions[player] = recordedShot.position;
+        }
+    }
+    if (recordedShot.position < 0 || recordedShot.position >= game.GetBoardSize()*game.GetBoardSize()) {
+        throw "The game record file holds a damaged game.";
+    }
+    attacked[1-recordedShot.player][recordedShot.position >> 6] |= uint64_t(1) << (recordedShot.position & 63);
+    shot++;
+    return true;
+}
+
+/*******************************************************************
+                GAME RECORD FILE CLASS
+********************************************************************/
+
+GameRecordFile::GameRecordFile(const string& path) {
+    this->data = NULL;
+    this->size = 0;
+#ifdef _WIN32
+    this->mapping = NULL;
+    this->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw "Could not open the game record file.";
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    this->size = fileSize.QuadPart;
+    if (size > 0) {
+        this->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        this->data = mapping ? (const uint8_t*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    }
+#else
+    this->file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw "Could not open the game record file.";
+    }
+    struct stat status;
+    fstat(file, &status);
+    this->size = status.st_size;
+    if (size > 0) {
+        void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+        this->data = mapped == MAP_FAILED ? NULL : (const uint8_t*) mapped;
+#ifdef MADV_SEQUENTIAL
+        if (data) madvise((void*) data, size, MADV_SEQUENTIAL);
+#endif
+    }
+#endif
+    if (data == NULL || size < sizeof(fileHeader) || !equal(fileHeader, fileHeader + sizeof(fileHeader), (const char*) data)) {
+        Close();
+        throw "This is not a game record file.";
+    }
+};
+
+GameRecordFile::~GameRecordFile() {
+    Close();
+};
+
+void GameRecordFile::Close() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+#else
+    if (data) munmap((void*) data, size);
+    if (file >= 0) close(file);
+    file = -1;
+#endif
+    data = NULL;
+}
+
+size_t GameRecordFile::GetFirstGameOffset() {
+    return sizeof(fileHeader);
+}
+
+bool GameRecordFile::ReadGame(size_t& offset, RecordedGame& game) {
+    if (offset >= size) {
+        return false;
+    }
+    if (size - offset < 4 + gameHeaderSize || size - offset - 4 < readUint32(data + offset)) {
+        throw "The game record file ends in the middle of a game.";
+    }
+    game = RecordedGame(data + offset + 4);
+    if (!game.FitsIn(readUint32(data + offset))) {
+        throw "The game record file holds a damaged game.";
+    }
+    offset += 4 + readUint32(data + offset);
+    return true;
+}
@@ -0,0 +1,202 @@
+#ifndef GAMERECORD_HPP
+#define GAMERECORD_HPP
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Board.hpp"
+#include "Ruleset.hpp"
+#include "AttackResult.hpp"
+
+using namespace std;
+
+// Compact binary record of complete games.
+//
+// A record file starts with the 8 byte file header "BSGR" 1 0 0 0 and is followed by any amount of games.
+// Every game is stored as (all numbers little endian):
+//   uint32  amount of bytes of the game that follow this field
+//   uint8   ruleset (the top bit is set for games with a seek index, see below), board size,
+//           winner (0 or 1, 255 if the game did not finish) and amount of ships per player
+//   uint32  amount of shots
+//   per player, per ship: uint16 first (lowest) position, uint8 size with the top bit set for vertical ships
+//   the shots, bit-packed from the lowest bit of every byte: 1 bit player, the position in as few bits
+//   as the board needs, 2 bits result
+// A shot on a 10x10 board takes 10 bits, so a typical classic game fits in about 200 bytes.
+//
+// Games on boards larger than 16x16 can run to thousands of shots, so they are stored with a seek index instead:
+//   the same header and ships
+//   uint32  keyframe interval, the amount of shots per segment
+//   uint32  offset of the index, counted from the ruleset byte
+//   the segments of shots. Every segment but the first starts with a keyframe: the attacked positions of
+//   the boards of player one and two before its first shot, as bitboard words of 8 bytes each.
+//   Then one byte tells how its shots are stored, whichever is smaller:
+//     0  a varint (7 bits per byte, lowest first) per shot of
+//        zigzag(position - previous position of the same player in the segment) << 3 | result << 1 | player,
+//        which is small while a ship is being targeted
+//     1  bit-packed like above
+//   the index: uint32 offset of every segment, counted from the ruleset byte
+// The boards at any shot are restored from the keyframe before it, decoding at most one interval of shots.
+
+// A ship of a recorded fleet.
+struct RecordedShip {
+    int origin;
+    bool vertical;
+    int size;
+};
+
+// A single attack of a recorded game.
+struct RecordedShot {
+    int player;
+    int position;
+    AttackResult result;
+};
+
+// Writes the header that every record file starts with.
+void writeGameRecordFileHeader(ostream& out);
+
+// Records games into a buffer in the record format.
+// Games are appended to the buffer until it is written to a file with `Flush`.
+class GameRecorder {
+    private:
+        // The buffer only grows; `byteCount` bytes of it are in use.
+        vector<uint8_t> bytes;
+        size_t byteCount;
+        // Offset of the game being recorded in `bytes`, or -1 if there is none.
+        long gameStart;
+        uint32_t shotCount;
+        int positionBits;
+        // Shot bits that do not fill a word yet.
+        uint64_t pendingBits;
+        int pendingBitCount;
+        vector<Ship*> seenShips;
+
+        // State of games with a seek index.
+        bool seekIndex;
+        int keyframeInterval;
+        // Offset of the keyframe interval and index offset fields in `bytes`.
+        size_t seekFieldsStart;
+        vector<uint64_t> attacked[2];
+        vector<uint32_t> segmentOffsets;
+        // The shots of the current segment, written once it is complete.
+        vector<RecordedShot> segmentShots;
+
+        // Returns room for `count` more bytes at the end of the buffer.
+        uint8_t* Append(int count);
+        void WriteFleet(Board& board);
+        void WritePackedShot(int player, int position, AttackResult result);
+        void FlushPackedShots();
+        void WriteVarint(uint32_t value);
+        void WriteSegment();
+        void WriteKeyframe();
+
+    public:
+        GameRecorder();
+        ~GameRecorder();
+
+        // Starts recording a game. The fleets are read from the boards, so the ships should be placed already.
+        void BeginGame(Ruleset ruleset, Board& boardPlayerOne, Board& boardPlayerTwo);
+        void AddShot(int player, int position, AttackResult result);
+        // Ends the game. `winner` is 0 or 1, or -1 if the game did not finish.
+        void EndGame(int winner);
+
+        const uint8_t* GetBytes() {return bytes.data();}
+        size_t GetByteCount() {return byteCount;}
+        // Writes all finished games to `out` and removes them from the buffer.
+        void Flush(ostream& out);
+};
+
+// A game inside a record file. Reads straight from the file; nothing is copied.
+class RecordedGame {
+    private:
+        const uint8_t* data;
+        int positionBits;
+
+        // Start of the shots, after the ships (and the seek fields).
+        const uint8_t* GetShotData() const;
+        int GetKeyframeInterval() const;
+        int GetSegmentCount() const;
+        // Returns the start of segment `segment`, the keyframe of all but the first.
+        const uint8_t* GetSegment(int segment) const;
+        const uint8_t* GetSegmentEnd(int segment) const;
+        // Whether the header is valid and the ships, shots and seek index all lie within the `length` bytes of the game.
+        bool FitsIn(uint32_t length) const;
+
+    public:
+        RecordedGame();
+        RecordedGame(const uint8_t* data);
+
+        Ruleset GetRuleset() const {return (Ruleset) (data[0] & 0x7f);}
+        // 'true' for games stored with keyframes and a seek index.
+        bool HasSeekIndex() const {return (data[0] & 0x80) != 0;}
+        int GetBoardSize() const {return data[1];}
+        // 0 or 1, or -1 if the game did not finish.
+        int GetWinner() const {return data[2] == 255 ? -1 : data[2];}
+        int GetShipCount() const {return data[3];}
+        int GetShotCount() const;
+        RecordedShip GetShip(int player, int ship) const;
+        // Any shot can be read directly. In games with a seek index this decodes from the keyframe before it,
+        // so use a `RecordedGameCursor` to read many shots in a row.
+        RecordedShot GetShot(int shot) const;
+
+        friend class RecordedGameCursor;
+        friend class GameRecordFile;
+};
+
+// Reads the shots of a recorded game in order from any shot on, and keeps track of the positions
+// attacked so far on both boards.
+class RecordedGameCursor {
+    private:
+        RecordedGame game;
+        int shot;
+        int keyframeInterval;
+        // Games with a seek index are read one segment at a time. `stream` is the next byte of a varint
+        // segment, or the first byte of a bit-packed one.
+        const uint8_t* stream, * segmentEnd;
+        bool packedSegment;
+        int previousPositions[2];
+        vector<uint64_t> attacked[2];
+
+    public:
+        // Starts at `shot`, with the boards as they were before that shot.
+        RecordedGameCursor(const RecordedGame& game, int shot);
+
+        // Number of the shot that `Next` returns.
+        int GetShotNumber() {return shot;}
+        // The positions of the board of `player` that have been attacked before the current shot.
+        Bitboard GetAttacked(int player) {return Bitboard(attacked[player].data(), game.GetBoardSize()*game.GetBoardSize());}
+        // Reads the current shot and moves to the next one. Returns 'false' after the last shot.
+        // Throws if the shot does not fit the game, which only happens for a damaged record.
+        bool Next(RecordedShot& recordedShot);
+};
+
+// A record file mapped into memory, so that files much larger than memory can be read.
+// Games are read in order with `ReadGame`.
+class GameRecordFile {
+    private:
+        const uint8_t* data;
+        size_t size;
+#ifdef _WIN32
+        void* file;
+        void* mapping;
+#else
+        int file;
+#endif
+
+        void Close();
+
+    public:
+        // Throws if the file can not be opened or is not a record file.
+        GameRecordFile(const string& path);
+        ~GameRecordFile();
+        GameRecordFile(const GameRecordFile&) = delete;
+        GameRecordFile& operator=(const GameRecordFile&) = delete;
+
+        size_t GetSize() {return size;}
+        // Offset of the first game.
+        size_t GetFirstGameOffset();
+        // Reads the game at `offset` and moves `offset` to the next game.
+        // Returns 'false' at the end of the file. Throws if the game is cut off or does not fit its length.
+        bool ReadGame(size_t& offset, RecordedGame& game);
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef GAMERULES_HPP
+#define GAMERULES_HPP
+#include "Board.hpp"
+#include "Ruleset.hpp"
+
+// The rules that differ between the kinds of games, as policies for code that knows the ruleset at compile time,
+// like the headless games (see `Simulation.hpp`). `ClassicGame` and `SalvoGame` apply the same rules.
+struct ClassicRules {
+    static const Ruleset ruleset = classic;
+    static int GetShotsPerTurn(Board& /*ownBoard*/, Board& /*enemyBoard*/) {return 1;}
+};
+
+struct SalvoRules {
+    static const Ruleset ruleset = salvo;
+    // The player can attack as many positions as the player has ships that have not been sunk,
+    // but never more than there are positions left to attack. These are counted only as far as needed,
+    // which is usually the first word of the plane.
+    static int GetShotsPerTurn(Board& ownBoard, Board& enemyBoard) {
+        return enemyBoard.GetAttackedPlane().CountUnset(ownBoard.GetShipsLeft());
+    }
+};
+
+// A player that keeps choosing positions that are not on the board or were attacked before forfeits the game
+// after this many illegal attacks in one turn, rather than being asked again forever.
+const int maxIllegalAttacks = 1000;
+
+#endif
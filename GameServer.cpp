@@ -0,0 +1,528 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <algorithm>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "GameServer.hpp"
+#include "GameSession.hpp"
+#include "FleetGenerator.hpp"
+#include "ServerProtocol.hpp"
+#include "ByteOrder.hpp"
+#include "Random.hpp"
+
+using namespace std;
+
+// Largest board a client can ask for, so that a single game can not take much memory.
+const int maxBoardSize = 100;
+// Amount of bytes read from a socket at once.
+const int readSize = 16384;
+
+struct HostedGame;
+
+// A connected client. It belongs to the event loop that has its socket in its epoll set.
+struct Connection {
+    int socket;
+    // Received bytes from `inputStart` on have not been handled yet.
+    vector<uint8_t> input;
+    size_t inputStart;
+    // Bytes that have not been written to the socket yet.
+    vector<uint8_t> output;
+    // 'true' while in the list of connections to write to, and while waiting for the socket to take more.
+    bool outputQueued, waitingToWrite;
+    // The game this client plays in, or NULL.
+    HostedGame* game;
+    int player;
+};
+
+struct HostedGame {
+    uint32_t id;
+    GameSession session;
+    Connection* players[2];
+
+    HostedGame(uint32_t id, Ruleset ruleset, int boardSize, const vector<int>& shipSizes) : id(id), session(ruleset, boardSize, shipSizes) {
+        players[0] = players[1] = NULL;
+    }
+};
+
+/*******************************************************************
+                EVENT LOOP CLASS
+********************************************************************/
+
+class GameServer::EventLoop {
+    private:
+        GameServer& server;
+        int index;
+        int epoll, wakeup;
+        unordered_set<Connection*> connections;
+        unordered_map<uint32_t, unique_ptr<HostedGame>> games;
+        uint32_t nextGame;
+        // Connections with output to write once the current events are handled.
+        vector<Connection*> pendingOutput, flushing;
+        mutex handOverLock;
+        vector<Connection*> handedOver;
+        map<int, unique_ptr<FleetGenerator>> fleetGenerators;
+        Random random;
+        vector<ShipPlacement> placements;
+        vector<int> positions;
+        vector<AttackResult> results;
+
+        void Accept();
+        void Read(Connection* connection);
+        void Write(Connection* connection);
+        void HandleRequests(Connection* connection);
+        // Returns 'false' if the connection has been handed over to another loop instead.
+        bool HandleRequest(Connection* connection, const uint8_t* request);
+        void Send(Connection* connection, const uint8_t* message, int length);
+        void SendFailure(Connection* connection, RequestStatus status);
+        void SendTurn(HostedGame* game);
+        void FlushOutput();
+        void EndGame(HostedGame* game);
+        void Close(Connection* connection);
+        void TakeHandedOver();
+        FleetGenerator& GetFleetGenerator(int boardSize);
+
+    public:
+        atomic<long> moveCount, finishedGameCount;
+
+        EventLoop(GameServer& server, int index);
+        ~EventLoop();
+
+        void Run();
+        void Wake();
+        // Called by another loop: this loop takes over `connection`, whose first request not handled yet is a `joinGame`.
+        void HandOver(Connection* connection);
+};
+
+GameServer::EventLoop::EventLoop(GameServer& server, int index) : server(server), random(random_device()() ^ (uint64_t) index << 32) {
+    this->index = index;
+    this->nextGame = 0;
+    this->moveCount = 0;
+    this->finishedGameCount = 0;
+    this->epoll = epoll_create1(EPOLL_CLOEXEC);
+    this->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll < 0 || wakeup < 0) {
+        throw "Could not create an event loop.";
+    }
+    // Every loop waits for new connections, but only one of them is woken for each.
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLEXCLUSIVE;
+    event.data.ptr = NULL;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, server.listenSocket, &event);
+    event.events = EPOLLIN;
+    event.data.ptr = &wakeup;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, wakeup, &event);
+};
+
+GameServer::EventLoop::~EventLoop() {
+    for (Connection* connection: handedOver) {
+        connections.insert(connection);
+    }
+    for (Connection* connection: connections) {
+        close(connection->socket);
+        delete connection;
+    }
+    close(wakeup);
+    close(epoll);
+};
+
+void GameServer::EventLoop::Run() {
+    epoll_event events[256];
+    while (!server.stopping) {
+        int count = epoll_wait(epoll, events, 256, -1);
+        for (int i=0; i<count; i++) {
+            void* source = events[i].data.ptr;
+            if (source == NULL) {
+                Accept();
+            } else if (source == &wakeup) {
+                uint64_t value;
+                if (read(wakeup, &value, sizeof(value)) > 0) {
+                    TakeHandedOver();
+                }
+            } else {
+                Connection* connection = (Connection*) source;
+                if ((events[i].events & EPOLLOUT) && !connection->outputQueued) {
+                    connection->outputQueued = true;
+                    pendingOutput.push_back(connection);
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    Read(connection);
+                }
+            }
+        }
+        FlushOutput();
+    }
+}
+
+void GameServer::EventLoop::Wake() {
+    uint64_t one = 1;
+    if (write(wakeup, &one, sizeof(one)) < 0) {
+        // The counter is full, so the loop is woken anyway.
+    }
+}
+
+// Takes one new connection. The other loops get the next ones, which keeps the connections spread over the loops.
+void GameServer::EventLoop::Accept() {
+    int socket = accept4(server.listenSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (socket < 0) {
+        return;
+    }
+    int on = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    Connection* connection = new Connection();
+    connection->socket = socket;
+    connection->inputStart = 0;
+    connection->outputQueued = connection->waitingToWrite = false;
+    connection->game = NULL;
+    connection->player = 0;
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = connection;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, socket, &event);
+    connections.insert(connection);
+}
+
+void GameServer::EventLoop::Read(Connection* connection) {
+    vector<uint8_t>& input = connection->input;
+    size_t used = input.size();
+    input.resize(used + readSize);
+    ssize_t received = recv(connection->socket, input.data() + used, readSize, 0);
+    input.resize(used + max(received, (ssize_t) 0));
+    if (received < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return;
+    }
+    if (received <= 0) {
+        Close(connection);
+        return;
+    }
+    HandleRequests(connection);
+}
+
+void GameServer::EventLoop::HandleRequests(Connection* connection) {
+    vector<uint8_t>& input = connection->input;
+    while (true) {
+        const uint8_t* request = input.data() + connection->inputStart;
+        int length = getRequestLength(request, input.size() - connection->inputStart);
+        if (length < 0) {
+            // Nothing after a malformed request can be trusted.
+            Close(connection);
+            return;
+        }
+        if (length == 0) {
+            break;
+        }
+        if (!HandleRequest(connection, request)) {
+            return;
+        }
+        connection->inputStart += length;
+    }
+    input.erase(input.begin(), input.begin() + connection->inputStart);
+    connection->inputStart = 0;
+}
+
+bool GameServer::EventLoop::HandleRequest(Connection* connection, const uint8_t* request) {
+    HostedGame* game = connection->game;
+    switch (request[0]) {
+    case createGame: {
+        int boardSize = request[2];
+        if (game) {
+            SendFailure(connection, alreadyInGame);
+        } else if (request[1] > salvo || boardSize < *max_element(server.shipSizes.begin(), server.shipSizes.end()) || boardSize > maxBoardSize) {
+            SendFailure(connection, badRequest);
+        } else {
+            // The id tells which loop the game lives in.
+            uint32_t id = nextGame++ * server.loops.size() + index;
+            game = new HostedGame(id, (Ruleset) request[1], boardSize, server.shipSizes);
+            games[id] = unique_ptr<HostedGame>(game);
+            game->players[0] = connection;
+            connection->game = game;
+            connection->player = 0;
+            uint8_t reply[5] = {gameCreated};
+            writeUint32(reply + 1, id);
+            Send(connection, reply, sizeof(reply));
+        }
+        break;
+    }
+    case joinGame: {
+        uint32_t id = readUint32(request + 1);
+        int owner = id % server.loops.size();
+        if (game) {
+            SendFailure(connection, alreadyInGame);
+        } else if (owner != index) {
+            // The connection leaves this loop with the join request still unhandled, and the owner of the game handles it.
+            epoll_ctl(epoll, EPOLL_CTL_DEL, connection->socket, NULL);
+            connections.erase(connection);
+            if (connection->outputQueued) {
+                pendingOutput.erase(find(pendingOutput.begin(), pendingOutput.end(), connection));
+                connection->outputQueued = false;
+            }
+            server.loops[owner]->HandOver(connection);
+            return false;
+        } else if (games.count(id) == 0 || games[id]->players[1] != NULL) {
+            SendFailure(connection, noSuchGame);
+        } else {
+            game = games[id].get();
+            game->players[1] = connection;
+            connection->game = game;
+            connection->player = 1;
+            for (int player=0; player<2; player++) {
+                uint8_t reply[4] = {gameJoined, (uint8_t) game->session.GetRuleset(), (uint8_t) game->session.GetBoardSize(), (uint8_t) player};
+                Send(game->players[player], reply, sizeof(reply));
+            }
+        }
+        break;
+    }
+    case placeFleet: {
+        if (!game) {
+            SendFailure(connection, notInGame);
+            break;
+        }
+        GameSession& session = game->session;
+        RequestStatus status;
+        if (request[1] == 0) {
+            status = session.PlaceRandomFleet(connection->player, GetFleetGenerator(session.GetBoardSize()), random);
+        } else {
+            placements.clear();
+            for (int ship=0; ship<request[1]; ship++) {
+                placements.push_back({readUint16(request + 2 + 3*ship), request[4 + 3*ship]});
+            }
+            status = session.PlaceFleet(connection->player, placements);
+        }
+        if (status != accepted) {
+            SendFailure(connection, status);
+            break;
+        }
+        uint8_t reply[1] = {fleetPlaced};
+        Send(connection, reply, sizeof(reply));
+        if (session.HasStarted()) {
+            SendTurn(game);
+        }
+        break;
+    }
+    case fire: {
+        if (!game) {
+            SendFailure(connection, notInGame);
+            break;
+        }
+        int count = request[1];
+        positions.resize(count);
+        results.resize(count);
+        for (int i=0; i<count; i++) {
+            positions[i] = readUint16(request + 2 + 2*i);
+        }
+        RequestStatus status = game->session.Fire(connection->player, positions.data(), count, results.data());
+        if (status != accepted) {
+            SendFailure(connection, status);
+            break;
+        }
+        moveCount.fetch_add(count, memory_order_relaxed);
+        // Both players see every turn.
+        uint8_t reply[maxMessageLength] = {fired, (uint8_t) connection->player, (uint8_t) count};
+        for (int i=0; i<count; i++) {
+            writeUint16(reply + 3 + 3*i, positions[i]);
+            reply[5 + 3*i] = (uint8_t) results[i];
+        }
+        for (int player=0; player<2; player++) {
+            Send(game->players[player], reply, 3 + 3*count);
+        }
+        if (game->session.HasFinished()) {
+            finishedGameCount.fetch_add(1, memory_order_relaxed);
+            EndGame(game);
+        } else {
+            SendTurn(game);
+        }
+        break;
+    }
+    }
+    return true;
+}
+
+void GameServer::EventLoop::Send(Connection* connection, const uint8_t* message, int length) {
+    connection->output.insert(connection->output.end(), message, message + length);
+    if (!connection->outputQueued) {
+        connection->outputQueued = true;
+        pendingOutput.push_back(connection);
+    }
+}
+
+void GameServer::EventLoop::SendFailure(Connection* connection, RequestStatus status) {
+    uint8_t reply[2] = {requestFailed, (uint8_t) status};
+    Send(connection, reply, sizeof(reply));
+}
+
+void GameServer::EventLoop::SendTurn(HostedGame* game) {
+    int player = game->session.GetTurn();
+    uint8_t reply[2] = {yourTurn, (uint8_t) game->session.GetShotsPerTurn(player)};
+    Send(game->players[player], reply, sizeof(reply));
+}
+
+// Writes all replies collected while handling the last events, one write per connection.
+void GameServer::EventLoop::FlushOutput() {
+    // Closing a connection can send to its opponent, so keep going until nothing is left.
+    while (!pendingOutput.empty()) {
+        flushing.swap(pendingOutput);
+        for (Connection* connection: flushing) {
+            connection->outputQueued = false;
+            Write(connection);
+        }
+        flushing.clear();
+    }
+}
+
+void GameServer::EventLoop::Write(Connection* connection) {
+    vector<uint8_t>& output = connection->output;
+    size_t written = 0;
+    while (written < output.size()) {
+        ssize_t sent = send(connection->socket, output.data() + written, output.size() - written, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && errno == EAGAIN) {
+            break;
+        }
+        if (sent < 0) {
+            Close(connection);
+            return;
+        }
+        written += sent;
+    }
+    output.erase(output.begin(), output.begin() + written);
+    // The socket is only watched for room to write while there is something left to write.
+    bool waitToWrite = !output.empty();
+    if (waitToWrite != connection->waitingToWrite) {
+        epoll_event event;
+        event.events = EPOLLIN | (waitToWrite ? (uint32_t) EPOLLOUT : 0);
+        event.data.ptr = connection;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, connection->socket, &event);
+        connection->waitingToWrite = waitToWrite;
+    }
+}
+
+void GameServer::EventLoop::EndGame(HostedGame* game) {
+    for (int player=0; player<2; player++) {
+        if (game->players[player]) {
+            game->players[player]->game = NULL;
+        }
+    }
+    games.erase(game->id);
+}
+
+void GameServer::EventLoop::Close(Connection* connection) {
+    HostedGame* game = connection->game;
+    if (game) {
+        Connection* opponent = game->players[!connection->player];
+        if (opponent) {
+            uint8_t message[1] = {opponentLeft};
+            Send(opponent, message, sizeof(message));
+        }
+        EndGame(game);
+    }
+    if (connection->outputQueued) {
+        pendingOutput.erase(find(pendingOutput.begin(), pendingOutput.end(), connection));
+    }
+    close(connection->socket);
+    connections.erase(connection);
+    delete connection;
+}
+
+void GameServer::EventLoop::HandOver(Connection* connection) {
+    {
+        lock_guard<mutex> guard(handOverLock);
+        handedOver.push_back(connection);
+    }
+    Wake();
+}
+
+void GameServer::EventLoop::TakeHandedOver() {
+    vector<Connection*> taken;
+    {
+        lock_guard<mutex> guard(handOverLock);
+        taken.swap(handedOver);
+    }
+    for (Connection* connection: taken) {
+        connections.insert(connection);
+        connection->waitingToWrite = false;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, connection->socket, &event);
+        if (!connection->output.empty()) {
+            connection->outputQueued = true;
+            pendingOutput.push_back(connection);
+        }
+        HandleRequests(connection);
+    }
+}
+
+FleetGenerator& GameServer::EventLoop::GetFleetGenerator(int boardSize) {
+    unique_ptr<FleetGenerator>& generator = fleetGenerators[boardSize];
+    if (!generator) {
+        generator.reset(new FleetGenerator(boardSize, server.shipSizes));
+    }
+    return *generator;
+}
+
+/*******************************************************************
+                GAME SERVER CLASS
+********************************************************************/
+
+GameServer::GameServer(int listenSocket, int loopCount, vector<int> shipSizes) {
+    this->listenSocket = listenSocket;
+    this->shipSizes = shipSizes;
+    this->stopping = false;
+    for (int i=0; i<max(loopCount, 1); i++) {
+        loops.push_back(unique_ptr<EventLoop>(new EventLoop(*this, i)));
+    }
+};
+
+GameServer::~GameServer() {
+    Stop();
+};
+
+long GameServer::GetMoveCount() {
+    long moves = 0;
+    for (unique_ptr<EventLoop>& loop: loops) {
+        moves += loop->moveCount.load(memory_order_relaxed);
+    }
+    return moves;
+}
+
+long GameServer::GetFinishedGameCount() {
+    long finishedGames = 0;
+    for (unique_ptr<EventLoop>& loop: loops) {
+        finishedGames += loop->finishedGameCount.load(memory_order_relaxed);
+    }
+    return finishedGames;
+}
+
+void GameServer::Start() {
+    for (unique_ptr<EventLoop>& loop: loops) {
+        EventLoop* eventLoop = loop.get();
+        threads.push_back(thread([eventLoop]() {eventLoop->Run();}));
+    }
+}
+
+void GameServer::Stop() {
+    stopping = true;
+    for (unique_ptr<EventLoop>& loop: loops) {
+        loop->Wake();
+    }
+    for (thread& loopThread: threads) {
+        loopThread.join();
+    }
+    threads.clear();
+}
@@ -0,0 +1,43 @@
+#ifndef GAMESERVER_HPP
+#define GAMESERVER_HPP
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+// Hosts many games between remote players at once (see `ServerProtocol.hpp` for the messages).
+//
+// The server runs one event loop per thread, each with its own epoll instance and non-blocking sockets. All loops wait on
+// the one listening socket, which wakes only one of them per new connection. A game lives in the loop of the player that
+// created it; a player that joins it from another loop has its connection handed over to that loop first. So a game and
+// its connections are only ever touched by one thread, and the loops share nothing but their hand-over queues.
+// Replies are collected while the requests of a wake-up are handled and written once per connection afterwards.
+class GameServer {
+    private:
+        class EventLoop;
+
+        int listenSocket;
+        vector<int> shipSizes;
+        vector<unique_ptr<EventLoop>> loops;
+        vector<thread> threads;
+        atomic<bool> stopping;
+
+    public:
+        // Serves games with the fleet `shipSizes` on the connections of `listenSocket`, which should be non-blocking.
+        GameServer(int listenSocket, int loopCount, vector<int> shipSizes);
+        ~GameServer();
+
+        int GetLoopCount() {return loops.size();}
+        // Amount of shots fired and games finished in all games so far.
+        long GetMoveCount();
+        long GetFinishedGameCount();
+
+        // Starts the event loops, each on its own thread.
+        void Start();
+        // Stops the event loops and closes all connections.
+        void Stop();
+};
+
+#endif
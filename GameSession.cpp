@@ -0,0 +1,68 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include "GameSession.hpp"
+#include "Board.hpp"
+
+using namespace std;
+
+GameSession::GameSession(Ruleset ruleset, int boardSize, const vector<int>& shipSizes)
+    : boardPlayerOne("Player one", boardSize), boardPlayerTwo("Player two", boardSize) {
+    this->ruleset = ruleset;
+    this->boardSize = boardSize;
+    this->shipSizes = shipSizes;
+    this->boards[0] = &boardPlayerOne;
+    this->boards[1] = &boardPlayerTwo;
+    this->fleetPlaced[0] = this->fleetPlaced[1] = false;
+    this->turn = 0;
+    this->winner = -1;
+};
+GameSession::~GameSession() {};
+
+RequestStatus GameSession::PlaceFleet(int player, const vector<ShipPlacement>& placements) {
+    if (fleetPlaced[player] || placements.size() != shipSizes.size()) {
+        return illegalPlacement;
+    }
+    Board& board = *boards[player];
+    for (size_t ship=0; ship<shipSizes.size(); ship++) {
+        const ShipPlacement& placement = placements[ship];
+        if (placement.origin < 0 || placement.origin >= boardSize*boardSize || placement.orientation < 0 || placement.orientation > 3
+            || getShipPositions(placement.origin, placement.orientation, shipSizes[ship], boardSize, board, shipPositions) != placed) {
+            board.Reset();
+            return illegalPlacement;
+        }
+        board.PlaceShip(shipPositions, shipSizes[ship]);
+    }
+    fleetPlaced[player] = true;
+    return accepted;
+}
+
+RequestStatus GameSession::PlaceRandomFleet(int player, FleetGenerator& generator, Random& random) {
+    if (fleetPlaced[player]) {
+        return illegalPlacement;
+    }
+    generator.Generate(random);
+    generator.PlaceFleet(*boards[player], shipPositions);
+    fleetPlaced[player] = true;
+    return accepted;
+}
+
+RequestStatus GameSession::Fire(int player, const int* positions, int count, AttackResult* results) {
+    if (!HasStarted() || HasFinished() || player != turn) {
+        return notYourTurn;
+    }
+    if (count != GetShotsPerTurn(player) || !boards[!player]->GetAttackedSalvo(positions, count, results)) {
+        return illegalShots;
+    }
+    // The salvo reports `won` for the shot that sinks the last ship.
+    for (int i=0; i<count; i++) {
+        if (results[i] == won) {
+            winner = player;
+        }
+    }
+    turn = !player;
+    return accepted;
+}
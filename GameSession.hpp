@@ -0,0 +1,65 @@
+#ifndef GAMESESSION_HPP
+#define GAMESESSION_HPP
+#include <vector>
+#include "Board.hpp"
+#include "FleetGenerator.hpp"
+#include "Random.hpp"
+#include "Ruleset.hpp"
+#include "GameRules.hpp"
+#include "AttackResult.hpp"
+#include "ServerProtocol.hpp"
+
+using namespace std;
+
+// A ship of a fleet placed by a remote player: its first position and orientation (0 up, 1 down, 2 left, 3 right).
+struct ShipPlacement {
+    int origin;
+    int orientation;
+};
+
+// A game between two remote players, driven one request at a time rather than by a loop that asks for input.
+// The rules are the same as in the interactive game: both players place their fleet, then player 0 attacks first
+// and the players take turns, attacking once per turn in a classic game and once per own ship left in a salvo game.
+class GameSession {
+    private:
+        Ruleset ruleset;
+        int boardSize;
+        vector<int> shipSizes;
+        Board boardPlayerOne, boardPlayerTwo;
+        Board* boards[2];
+        bool fleetPlaced[2];
+        int turn;
+        // 0 or 1 once the game is won, -1 before.
+        int winner;
+        vector<int> shipPositions;
+
+    public:
+        GameSession(Ruleset ruleset, int boardSize, const vector<int>& shipSizes);
+        ~GameSession();
+
+        Ruleset GetRuleset() {return ruleset;}
+        int GetBoardSize() {return boardSize;}
+        Board& GetBoard(int player) {return *boards[player];}
+        bool HasStarted() {return fleetPlaced[0] && fleetPlaced[1];}
+        bool HasFinished() {return winner >= 0;}
+        int GetWinner() {return winner;}
+        // The player that attacks next.
+        int GetTurn() {return turn;}
+        // Amount of shots `player` fires in one turn, by the rules of the engine (see `GameRules.hpp`).
+        int GetShotsPerTurn(int player) {
+            if (ruleset == classic) {
+                return ClassicRules::GetShotsPerTurn(*boards[player], *boards[!player]);
+            }
+            return SalvoRules::GetShotsPerTurn(*boards[player], *boards[!player]);
+        }
+
+        // Places the fleet of `player`, one placement per ship of the fleet. A fleet that does not fit is not placed.
+        RequestStatus PlaceFleet(int player, const vector<ShipPlacement>& placements);
+        // Places the fleet of `player` at random. `generator` must be for the board size and fleet of this game.
+        RequestStatus PlaceRandomFleet(int player, FleetGenerator& generator, Random& random);
+        // Fires the shots of the turn of `player` and stores their results in `results`.
+        // Either all shots are fired or, if they are not all legal, none of them.
+        RequestStatus Fire(int player, const int* positions, int count, AttackResult* results);
+};
+
+#endif
@@ -0,0 +1,280 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <stdio.h>
+#include "Metrics.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+#ifdef MSG_NOSIGNAL
+static const int noSignal = MSG_NOSIGNAL;
+#else
+static const int noSignal = 0;
+#endif
+
+using namespace std;
+
+static const char* counterNames[metricsCounterCount] = {"games", "turns", "shots", "hits", "sinks", "invalid_attacks", "exceptions"};
+static const char* counterHelp[metricsCounterCount] = {"Games finished.", "Turns played.", "Positions attacked.",
+    "Attacks that hit a ship.", "Attacks that sunk a ship.", "Attacks refused because of an attacked or invalid position.",
+    "Errors thrown and handled."};
+static const char* histogramNames[metricsHistogramCount] = {"attack", "decision", "render", "input_wait"};
+static const char* histogramHelp[metricsHistogramCount] = {"Time to carry out an attack on a board.",
+    "Time a computer player takes to choose an attack.", "Time to draw a board.", "Time spent waiting for input."};
+static const double percentiles[] = {0.5, 0.9, 0.99, 0.999};
+
+bool hasMetrics() {
+#ifdef BATTLESHIP_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*******************************************************************
+                LATENCY HISTOGRAM
+********************************************************************/
+
+// Returns the index of the highest set bit of a word that is not 0.
+static int highestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (int) index;
+#else
+    return 63 - __builtin_clzll(word);
+#endif
+}
+
+// Latencies below `subBucketCount` ns get a bucket each. Above that, every power of two is split into
+// `subBucketCount` buckets by the bits below the highest one.
+int LatencyHistogram::GetBucket(uint64_t nanoseconds) {
+    if (nanoseconds < (uint64_t) subBucketCount) {
+        return (int) nanoseconds;
+    }
+    int shift = highestBit(nanoseconds) - subBucketBits;
+    return (shift + 1)*subBucketCount + (int) (nanoseconds >> shift) - subBucketCount;
+}
+
+uint64_t LatencyHistogram::GetBucketStart(int bucket) {
+    if (bucket < subBucketCount) {
+        return bucket;
+    }
+    int shift = bucket / subBucketCount - 1;
+    return (uint64_t) (bucket % subBucketCount + subBucketCount) << shift;
+}
+
+LatencyHistogram::LatencyHistogram() : count(0), sum(0), max(0) {
+    for (int i=0; i<bucketCount; i++) {
+        buckets[i].store(0, memory_order_relaxed);
+    }
+};
+
+void LatencyHistogram::AddTo(vector<uint64_t>& totalBuckets, uint64_t& totalCount, uint64_t& totalSum, uint64_t& totalMax) const {
+    for (int i=0; i<bucketCount; i++) {
+        totalBuckets[i] += buckets[i].load(memory_order_relaxed);
+    }
+    totalCount += count.load(memory_order_relaxed);
+    totalSum += sum.load(memory_order_relaxed);
+    uint64_t shardMax = max.load(memory_order_relaxed);
+    if (shardMax > totalMax) {
+        totalMax = shardMax;
+    }
+}
+
+uint64_t MetricsSnapshot::Histogram::GetPercentile(double fraction) const {
+    uint64_t rank = (uint64_t) (fraction * count + 0.5), seen = 0;
+    for (size_t i=0; i<buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= rank) {
+            // The highest latency of the bucket, as it is not known where in the bucket the latencies were.
+            uint64_t end = i+1 < buckets.size() ? LatencyHistogram::GetBucketStart(i+1) - 1 : max;
+            return end < max ? end : max;
+        }
+    }
+    return 0;
+}
+
+/*******************************************************************
+                SHARDS
+********************************************************************/
+
+MetricsShard::MetricsShard() {
+    for (int i=0; i<metricsCounterCount; i++) {
+        counters[i].store(0, memory_order_relaxed);
+    }
+};
+
+static mutex shardsMutex;
+static vector<unique_ptr<MetricsShard>> shards;
+
+MetricsShard& getMetricsShard() {
+    thread_local MetricsShard* shard = NULL;
+    if (!shard) {
+        lock_guard<mutex> lock(shardsMutex);
+        shards.push_back(unique_ptr<MetricsShard>(new MetricsShard()));
+        shard = shards.back().get();
+    }
+    return *shard;
+}
+
+MetricsSnapshot collectMetrics() {
+    MetricsSnapshot metrics;
+    for (int i=0; i<metricsCounterCount; i++) {
+        metrics.counters[i] = 0;
+    }
+    for (int i=0; i<metricsHistogramCount; i++) {
+        metrics.histograms[i].buckets.assign(LatencyHistogram::bucketCount, 0);
+        metrics.histograms[i].count = metrics.histograms[i].sum = metrics.histograms[i].max = 0;
+    }
+    lock_guard<mutex> lock(shardsMutex);
+    for (const unique_ptr<MetricsShard>& shard: shards) {
+        for (int i=0; i<metricsCounterCount; i++) {
+            metrics.counters[i] += shard->counters[i].load(memory_order_relaxed);
+        }
+        for (int i=0; i<metricsHistogramCount; i++) {
+            MetricsSnapshot::Histogram& histogram = metrics.histograms[i];
+            shard->histograms[i].AddTo(histogram.buckets, histogram.count, histogram.sum, histogram.max);
+        }
+    }
+    return metrics;
+}
+
+/*******************************************************************
+                FORMATS
+********************************************************************/
+
+string formatMetricsPrometheus(const MetricsSnapshot& metrics) {
+    string text;
+    char line[256];
+    for (int i=0; i<metricsCounterCount; i++) {
+        snprintf(line, sizeof(line), "# HELP battleship_%s_total %s\n# TYPE battleship_%s_total counter\nbattleship_%s_total %llu\n",
+            counterNames[i], counterHelp[i], counterNames[i], counterNames[i], (unsigned long long) metrics.counters[i]);
+        text += line;
+    }
+    for (int i=0; i<metricsHistogramCount; i++) {
+        const MetricsSnapshot::Histogram& histogram = metrics.histograms[i];
+        const char* name = histogramNames[i];
+        snprintf(line, sizeof(line), "# HELP battleship_%s_seconds %s\n# TYPE battleship_%s_seconds summary\n", name, histogramHelp[i], name);
+        text += line;
+        for (double fraction: percentiles) {
+            snprintf(line, sizeof(line), "battleship_%s_seconds{quantile=\"%g\"} %.9f\n", name, fraction, histogram.GetPercentile(fraction) * 1e-9);
+            text += line;
+        }
+        snprintf(line, sizeof(line), "battleship_%s_seconds_sum %.9f\nbattleship_%s_seconds_count %llu\n",
+            name, histogram.sum * 1e-9, name, (unsigned long long) histogram.count);
+        text += line;
+        snprintf(line, sizeof(line), "# TYPE battleship_%s_seconds_max gauge\nbattleship_%s_seconds_max %.9f\n", name, name, histogram.max * 1e-9);
+        text += line;
+    }
+    return text;
+}
+
+string formatMetricsJson(const MetricsSnapshot& metrics) {
+    string json = "{\"counters\": {";
+    char value[256];
+    for (int i=0; i<metricsCounterCount; i++) {
+        snprintf(value, sizeof(value), "%s\"%s\": %llu", i ? ", " : "", counterNames[i], (unsigned long long) metrics.counters[i]);
+        json += value;
+    }
+    json += "}, \"latencies_ns\": {";
+    for (int i=0; i<metricsHistogramCount; i++) {
+        const MetricsSnapshot::Histogram& histogram = metrics.histograms[i];
+        snprintf(value, sizeof(value), "%s\"%s\": {\"count\": %llu, \"mean\": %.1f, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+            i ? ", " : "", histogramNames[i], (unsigned long long) histogram.count, histogram.count ? (double) histogram.sum / histogram.count : 0.0,
+            (unsigned long long) histogram.GetPercentile(0.5), (unsigned long long) histogram.GetPercentile(0.9),
+            (unsigned long long) histogram.GetPercentile(0.99), (unsigned long long) histogram.GetPercentile(0.999),
+            (unsigned long long) histogram.max);
+        json += value;
+    }
+    json += "}}\n";
+    return json;
+}
+
+/*******************************************************************
+                METRICS REPORTER
+********************************************************************/
+
+MetricsReporter::MetricsReporter(const string& target, double intervalSeconds) {
+    this->target = target;
+    this->interval = chrono::milliseconds((long long) (intervalSeconds * 1000));
+    this->stopping = false;
+    this->reporter = thread(&MetricsReporter::Run, this);
+};
+
+MetricsReporter::~MetricsReporter() {
+    {
+        lock_guard<mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopCondition.notify_one();
+    reporter.join();
+    Report();
+};
+
+void MetricsReporter::Run() {
+    unique_lock<mutex> lock(stopMutex);
+    while (!stopCondition.wait_for(lock, interval, [this]() {return stopping;})) {
+        lock.unlock();
+        Report();
+        lock.lock();
+    }
+}
+
+bool MetricsReporter::Report() {
+    MetricsSnapshot metrics = collectMetrics();
+    if (target.compare(0, 5, "unix:") == 0) {
+#ifdef _WIN32
+        return false;
+#else
+        string text = formatMetricsPrometheus(metrics);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        string path = target.substr(5);
+        if (path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        path.copy(address.sun_path, path.size());
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return false;
+        }
+        bool sent = connect(fd, (sockaddr*) &address, sizeof(address)) == 0;
+        for (size_t written = 0; sent && written < text.size(); ) {
+            ssize_t count = send(fd, text.data() + written, text.size() - written, noSignal);
+            sent = count > 0;
+            written += sent ? count : 0;
+        }
+        close(fd);
+        return sent;
+#endif
+    }
+    bool json = target.size() >= 5 && target.compare(target.size() - 5, 5, ".json") == 0;
+    string temporaryPath = target + ".tmp";
+    {
+        ofstream file(temporaryPath, ios::binary | ios::trunc);
+        file << (json ? formatMetricsJson(metrics) : formatMetricsPrometheus(metrics));
+        if (!file) {
+            return false;
+        }
+    }
+    // Replacing the file is atomic where it already exists, except on Windows where it has to be removed first.
+#ifdef _WIN32
+    remove(target.c_str());
+#endif
+    return rename(temporaryPath.c_str(), target.c_str()) == 0;
+}
@@ -0,0 +1,139 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+using namespace std;
+
+// Counters and latency histograms of the game engine, to see where the time of a turn goes.
+//
+// They are only compiled in when building with -DBATTLESHIP_METRICS (then add `Metrics.cpp` to every program).
+// Without it `METRICS_COUNT` and `METRICS_TIME` do nothing and cost nothing, and nothing is reported.
+//
+// Every thread counts into its own shard without locks or shared cache lines, and the shards are only added up
+// when the metrics are reported, so the tournament does not slow down with more threads.
+
+enum MetricsCounter {gamesCounter, turnsCounter, shotsCounter, hitsCounter, sinksCounter, invalidAttacksCounter,
+    exceptionsCounter, metricsCounterCount};
+enum MetricsHistogram {attackHistogram, decisionHistogram, renderHistogram, inputWaitHistogram, metricsHistogramCount};
+
+// Latencies in nanoseconds, HDR style: 16 buckets per power of two, so every latency is kept to within 6.25%
+// whether it took nanoseconds or minutes.
+class LatencyHistogram {
+    public:
+        static const int subBucketBits = 4;
+        static const int subBucketCount = 1 << subBucketBits;
+        static const int bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+        static int GetBucket(uint64_t nanoseconds);
+        // The smallest latency that falls in `bucket`.
+        static uint64_t GetBucketStart(int bucket);
+
+    private:
+        // Only written by the thread the histogram belongs to, so they are atomic only to be read by the reporter.
+        atomic<uint64_t> buckets[bucketCount];
+        atomic<uint64_t> count, sum, max;
+
+    public:
+        LatencyHistogram();
+
+        void Record(uint64_t nanoseconds) {
+            atomic<uint64_t>& bucket = buckets[GetBucket(nanoseconds)];
+            bucket.store(bucket.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            count.store(count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+            sum.store(sum.load(memory_order_relaxed) + nanoseconds, memory_order_relaxed);
+            if (nanoseconds > max.load(memory_order_relaxed)) {
+                max.store(nanoseconds, memory_order_relaxed);
+            }
+        }
+        // Adds the counts of this histogram to `total`, which has `bucketCount` buckets.
+        void AddTo(vector<uint64_t>& totalBuckets, uint64_t& totalCount, uint64_t& totalSum, uint64_t& totalMax) const;
+};
+
+// The metrics of one thread.
+struct MetricsShard {
+    atomic<uint64_t> counters[metricsCounterCount];
+    LatencyHistogram histograms[metricsHistogramCount];
+
+    MetricsShard();
+    void Add(MetricsCounter counter, uint64_t amount) {
+        counters[counter].store(counters[counter].load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+};
+
+// Returns the shard of the calling thread. It is kept after the thread ends, so nothing counted is lost.
+MetricsShard& getMetricsShard();
+
+// Records the time from its creation to the end of its scope in a histogram of the calling thread.
+class MetricsTimer {
+    private:
+        MetricsHistogram histogram;
+        chrono::steady_clock::time_point start;
+
+    public:
+        MetricsTimer(MetricsHistogram histogram) : histogram(histogram), start(chrono::steady_clock::now()) {}
+        ~MetricsTimer() {
+            uint64_t nanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            getMetricsShard().histograms[histogram].Record(nanoseconds);
+        }
+};
+
+#ifdef BATTLESHIP_METRICS
+#define METRICS_COUNT(counter, amount) getMetricsShard().Add(counter, amount)
+#define METRICS_JOIN(a, b) a##b
+#define METRICS_TIMER_NAME(line) METRICS_JOIN(metricsTimer, line)
+#define METRICS_TIME(histogram) MetricsTimer METRICS_TIMER_NAME(__LINE__)(histogram)
+#else
+#define METRICS_COUNT(counter, amount) ((void) 0)
+#define METRICS_TIME(histogram) ((void) 0)
+#endif
+
+// Whether this build has metrics (see above).
+bool hasMetrics();
+
+// The metrics of all threads added up.
+struct MetricsSnapshot {
+    uint64_t counters[metricsCounterCount];
+    struct Histogram {
+        vector<uint64_t> buckets;
+        uint64_t count, sum, max;
+        // The latency below which `fraction` of the recorded latencies lie, to within the precision of a bucket.
+        uint64_t GetPercentile(double fraction) const;
+    } histograms[metricsHistogramCount];
+};
+
+MetricsSnapshot collectMetrics();
+// Formats metrics as text for Prometheus (counters, and histograms as summaries in seconds), or as one JSON object.
+string formatMetricsPrometheus(const MetricsSnapshot& metrics);
+string formatMetricsJson(const MetricsSnapshot& metrics);
+
+// Writes the metrics every few seconds from a thread of its own, and once more when it is destroyed.
+// The target is a file, written as JSON if its name ends in ".json" and as Prometheus text otherwise (e.g. for the
+// textfile collector of node_exporter), which is replaced at once so it is never read half written.
+// Or "unix:PATH", the Unix domain socket of a collector, which is sent the Prometheus text over a new connection
+// every time.
+class MetricsReporter {
+    private:
+        string target;
+        chrono::milliseconds interval;
+        mutex stopMutex;
+        condition_variable stopCondition;
+        bool stopping;
+        thread reporter;
+
+        void Run();
+
+    public:
+        MetricsReporter(const string& target, double intervalSeconds);
+        ~MetricsReporter();
+        // Writes the metrics now. Returns 'false' if the target could not be written.
+        bool Report();
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <cstddef>
+#include "PlacementMasks.hpp"
+
+using namespace std;
+
+template<int BoardSize, int ShipSize>
+const uint64_t* lookUpPlacementMask(int initIndex, int orientation, bool& legal) {
+    const PlacementMask<BoardSize>& mask = placementMaskTable<BoardSize, ShipSize>.Get(initIndex, orientation);
+    legal = mask.legal;
+    return mask.words;
+}
+
+template<int BoardSize>
+const uint64_t* lookUpPlacementMask(int shipSize, int initIndex, int orientation, bool& legal) {
+    switch (shipSize) {
+    case 1: return lookUpPlacementMask<BoardSize, 1>(initIndex, orientation, legal);
+    case 2: return lookUpPlacementMask<BoardSize, 2>(initIndex, orientation, legal);
+    case 3: return lookUpPlacementMask<BoardSize, 3>(initIndex, orientation, legal);
+    case 4: return lookUpPlacementMask<BoardSize, 4>(initIndex, orientation, legal);
+    case 5: return lookUpPlacementMask<BoardSize, 5>(initIndex, orientation, legal);
+    case 6: return lookUpPlacementMask<BoardSize, 6>(initIndex, orientation, legal);
+    default: return NULL;
+    }
+}
+
+const uint64_t* getPlacementMask(int boardSize, int shipSize, int initIndex, int orientation, bool& legal) {
+    if (initIndex < 0 || initIndex >= boardSize*boardSize || orientation < 0 || orientation > 3) {
+        return NULL;
+    }
+    switch (boardSize) {
+    case 8: return lookUpPlacementMask<8>(shipSize, initIndex, orientation, legal);
+    case 10: return lookUpPlacementMask<10>(shipSize, initIndex, orientation, legal);
+    case 12: return lookUpPlacementMask<12>(shipSize, initIndex, orientation, legal);
+    case 16: return lookUpPlacementMask<16>(shipSize, initIndex, orientation, legal);
+    default: return NULL;
+    }
+}
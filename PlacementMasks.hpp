@@ -0,0 +1,62 @@
+#ifndef PLACEMENTMASKS_HPP
+#define PLACEMENTMASKS_HPP
+#include <cstdint>
+
+using namespace std;
+
+// The positions a ship covers for one initial position and orientation, as bits over the board.
+// `legal` is 'false' if the ship would not fit on the board; the bits then only cover the part that fits.
+template<int BoardSize>
+struct PlacementMask {
+    static const int wordCount = (BoardSize*BoardSize + 63) / 64;
+    bool legal;
+    uint64_t words[wordCount];
+};
+
+// Masks of every placement of a ship of size `ShipSize` on a board of size `BoardSize`,
+// indexed by initial position * 4 + orientation (0 up, 1 down, 2 left, 3 right). Built by the compiler.
+template<int BoardSize, int ShipSize>
+struct PlacementMaskTable {
+    PlacementMask<BoardSize> entries[BoardSize*BoardSize*4];
+
+    constexpr PlacementMaskTable() : entries() {
+        for (int initIndex=0; initIndex<BoardSize*BoardSize; initIndex++) {
+            int x = initIndex % BoardSize, y = initIndex / BoardSize;
+            for (int orientation=0; orientation<4; orientation++) {
+                PlacementMask<BoardSize>& mask = entries[initIndex*4 + orientation];
+                int dx = orientation == 2 ? -1 : orientation == 3 ? 1 : 0;
+                int dy = orientation == 0 ? -1 : orientation == 1 ? 1 : 0;
+                mask.legal = true;
+                for (int w=0; w<PlacementMask<BoardSize>::wordCount; w++) {
+                    mask.words[w] = 0;
+                }
+                for (int i=0; i<ShipSize; i++) {
+                    int px = x + i*dx, py = y + i*dy;
+                    if (px < 0 || px >= BoardSize || py < 0 || py >= BoardSize) {
+                        mask.legal = false;
+                    } else {
+                        int posIndex = px + py*BoardSize;
+                        mask.words[posIndex / 64] |= uint64_t(1) << (posIndex % 64);
+                    }
+                }
+            }
+        }
+    }
+
+    constexpr const PlacementMask<BoardSize>& Get(int initIndex, int orientation) const {
+        return entries[initIndex*4 + orientation];
+    }
+};
+
+template<int BoardSize, int ShipSize>
+inline constexpr PlacementMaskTable<BoardSize, ShipSize> placementMaskTable{};
+
+// Largest ship that has tables.
+const int maxTableShipSize = 6;
+
+// Looks up a placement in the tables for a board size known only at run time.
+// Tables exist for boards of size 8, 10, 12 and 16 and ships up to `maxTableShipSize`.
+// Returns the mask words and sets `legal`, or returns NULL if there is no table for these sizes.
+const uint64_t* getPlacementMask(int boardSize, int shipSize, int initIndex, int orientation, bool& legal);
+
+#endif
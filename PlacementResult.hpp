@@ -0,0 +1,6 @@
+#ifndef PLACEMENTRESULT_HPP
+#define PLACEMENTRESULT_HPP
+
+enum PlacementResult {placed, offBoard, overlap};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <memory>
+#include <future>
+#include <algorithm>
+#include "Player.hpp"
+#include "Strategy.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+future<void> makeReadyFuture() {
+    promise<void> answer;
+    answer.set_value();
+    return answer.get_future();
+}
+
+// A strategy picks one position at a time and does not know about the positions picked before in the same salvo,
+// so a position it picks twice is replaced by a random one that has not been attacked yet.
+void chooseStrategySalvo(Strategy& strategy, const EnemyBoardView& enemyBoard, int count, Random& random, vector<int>& salvo) {
+    METRICS_TIME(decisionHistogram);
+    salvo.clear();
+    while ((int) salvo.size() < count) {
+        int posIndex = strategy.ChooseAttack(enemyBoard);
+        while (find(salvo.begin(), salvo.end(), posIndex) != salvo.end() || enemyBoard.HasBeenAttacked(posIndex)) {
+            posIndex = random.NextBelow(enemyBoard.GetSize()*enemyBoard.GetSize());
+        }
+        salvo.push_back(posIndex);
+    }
+}
+
+/*******************************************************************
+                STRATEGY PLAYER
+********************************************************************/
+
+StrategyPlayer::StrategyPlayer(unique_ptr<Strategy> strategy, int boardSize, uint64_t seed) : strategy(move(strategy)), random(seed) {
+    this->strategy->NewGame(boardSize);
+};
+StrategyPlayer::~StrategyPlayer() {};
+
+future<void> StrategyPlayer::PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+    strategy->PlaceShips(ownBoard, shipSizes);
+    return makeReadyFuture();
+}
+
+future<vector<int>> StrategyPlayer::ChooseAttack(Board& /*ownBoard*/, const EnemyBoardView& enemyBoard, int count) {
+    vector<int> salvo;
+    chooseStrategySalvo(*strategy, enemyBoard, count, random, salvo);
+    return makeReadyFuture(salvo);
+}
+
+void StrategyPlayer::ReceiveAttackResult(int positionIndex, AttackResult result) {
+    strategy->ReceiveAttackResult(positionIndex, result);
+}
@@ -0,0 +1,66 @@
+#ifndef PLAYER_HPP
+#define PLAYER_HPP
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <chrono>
+#include "Board.hpp"
+#include "EnemyBoardView.hpp"
+#include "AttackResult.hpp"
+#include "Strategy.hpp"
+#include "Random.hpp"
+
+using namespace std;
+
+// A player of an interactive game (see `Game`): a person at the terminal, a strategy in the same process,
+// or a program in another process or on the other end of a connection.
+// A player is asked for its moves and answers through a future, which may only become ready long after the
+// request returned. The game polls the future instead of waiting for it, so one thread can drive many games at once.
+class Player {
+    public:
+        virtual ~Player() {};
+
+        // Places the fleet of `shipSizes` on `ownBoard`. Ready once all ships are placed.
+        virtual future<void> PlaceShips(Board& ownBoard, const vector<int>& shipSizes) = 0;
+        // Chooses `count` different positions on the enemy's board that have not been attacked yet.
+        // A player that answers later should keep a copy of `enemyBoard` rather than the reference.
+        virtual future<vector<int>> ChooseAttack(Board& ownBoard, const EnemyBoardView& enemyBoard, int count) = 0;
+        // Called for every position attacked by this player, once its turn is over.
+        virtual void ReceiveAttackResult(int /*positionIndex*/, AttackResult /*result*/) {};
+};
+
+// Returns a future that is ready already, for players that answer right away.
+template<typename T>
+future<T> makeReadyFuture(T value) {
+    promise<T> answer;
+    answer.set_value(move(value));
+    return answer.get_future();
+}
+future<void> makeReadyFuture();
+
+// Whether `answer` is ready, without waiting for it.
+template<typename T>
+bool isReady(const future<T>& answer) {
+    return answer.wait_for(chrono::seconds(0)) == future_status::ready;
+}
+
+// Lets `strategy` choose `count` different positions to attack, none attacked before, into `salvo`.
+void chooseStrategySalvo(Strategy& strategy, const EnemyBoardView& enemyBoard, int count, Random& random, vector<int>& salvo);
+
+// Lets a strategy of the headless games (see `Strategy.hpp`) play an interactive game. It answers right away.
+class StrategyPlayer: public Player {
+    private:
+        unique_ptr<Strategy> strategy;
+        Random random;
+
+    public:
+        StrategyPlayer(unique_ptr<Strategy> strategy, int boardSize, uint64_t seed);
+        ~StrategyPlayer();
+
+        future<void> PlaceShips(Board& ownBoard, const vector<int>& shipSizes);
+        future<vector<int>> ChooseAttack(Board& ownBoard, const EnemyBoardView& enemyBoard, int count);
+        void ReceiveAttackResult(int positionIndex, AttackResult result);
+};
+
+#endif
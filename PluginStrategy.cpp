@@ -0,0 +1,173 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <string>
+#include <memory>
+#include <map>
+#include <mutex>
+#include "PluginStrategy.hpp"
+#include "Board.hpp"
+#include "Strategy.hpp"
+#include "BattleshipPlugin.h"
+#include "Metrics.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+using namespace std;
+
+// The interface passes these as they are.
+static_assert(sizeof(int) == sizeof(int32_t), "Ship sizes and placements are passed to plugins without conversion.");
+static_assert((int) miss == BATTLESHIP_MISS && (int) hit == BATTLESHIP_HIT && (int) sunk == BATTLESHIP_SUNK && (int) won == BATTLESHIP_WON,
+    "Attack results are passed to plugins without conversion.");
+
+/*******************************************************************
+                STRATEGY PLUGIN
+********************************************************************/
+
+StrategyPlugin::StrategyPlugin(const string& path) {
+    this->path = path;
+#ifdef _WIN32
+    this->library = (void*) LoadLibraryA(path.c_str());
+#else
+    this->library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+    if (!library) {
+        throw "Could not load the plugin.";
+    }
+#ifdef _WIN32
+    BattleshipPluginEntry entry = (BattleshipPluginEntry) GetProcAddress((HMODULE) library, BATTLESHIP_PLUGIN_ENTRY_NAME);
+#else
+    BattleshipPluginEntry entry = (BattleshipPluginEntry) dlsym(library, BATTLESHIP_PLUGIN_ENTRY_NAME);
+#endif
+    this->api = entry ? entry() : NULL;
+    if (!api || api->api_version != BATTLESHIP_PLUGIN_API_VERSION || !api->create || !api->destroy || !api->choose_attack) {
+#ifdef _WIN32
+        FreeLibrary((HMODULE) library);
+#else
+        dlclose(library);
+#endif
+        throw "The library is not a plugin for this version of the game.";
+    }
+};
+
+StrategyPlugin::~StrategyPlugin() {
+#ifdef _WIN32
+    FreeLibrary((HMODULE) library);
+#else
+    dlclose(library);
+#endif
+};
+
+// Plugins are kept loaded until the end of the process, so strategies can be created from any thread cheaply.
+shared_ptr<StrategyPlugin> loadStrategyPlugin(const string& path) {
+    static mutex pluginsMutex;
+    static map<string, shared_ptr<StrategyPlugin>> plugins;
+    lock_guard<mutex> lock(pluginsMutex);
+    shared_ptr<StrategyPlugin>& plugin = plugins[path];
+    if (!plugin) {
+        try {
+            plugin = make_shared<StrategyPlugin>(path);
+        } catch (const char*) {
+            plugins.erase(path);
+            throw;
+        }
+    }
+    return plugin;
+}
+
+/*******************************************************************
+                PLUGIN STRATEGY
+********************************************************************/
+
+PluginStrategy::PluginStrategy(shared_ptr<StrategyPlugin> plugin, uint64_t seed) : RandomStrategy(seed), plugin(plugin), api(plugin->GetApi()) {
+    this->bot = api.create(seed);
+    this->remainingShipsLeft = -1;
+    this->remainingShipSizesKnown = false;
+    if (!bot) {
+        throw "The plugin could not create a bot.";
+    }
+};
+
+PluginStrategy::~PluginStrategy() {
+    api.destroy(bot);
+};
+
+void PluginStrategy::NewGame(int boardSize) {
+    RandomStrategy::NewGame(boardSize);
+    this->remainingShipsLeft = -1;
+    if (api.new_game) {
+        api.new_game(bot, boardSize);
+    }
+}
+
+void PluginStrategy::PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+    if (!api.place_ships) {
+        RandomStrategy::PlaceShips(ownBoard, shipSizes);
+        return;
+    }
+    int size = ownBoard.GetSize();
+    placements.assign(3*shipSizes.size(), 0);
+    if (api.place_ships(bot, size, shipSizes.data(), shipSizes.size(), placements.data()) != 0) {
+        throw "The plugin could not place its ships.";
+    }
+    for (size_t i=0; i<shipSizes.size(); i++) {
+        int x = placements[3*i], y = placements[3*i+1], orientation = placements[3*i+2];
+        if (x < 0 || x >= size || y < 0 || y >= size || orientation < 0 || orientation > 3
+            || getShipPositions(x + y*size, orientation, shipSizes[i], size, ownBoard, positionIndices) != placed) {
+            throw "The plugin placed a ship where it does not fit.";
+        }
+        ownBoard.PlaceShip(positionIndices, shipSizes[i]);
+    }
+}
+
+// The view points straight at the planes of the enemy's board. The sizes of the ships left only change when
+// a ship is sunk, so they are only asked for again then.
+int PluginStrategy::ChooseAttack(const EnemyBoardView& enemyBoard) {
+    if (enemyBoard.GetShipsLeft() != remainingShipsLeft) {
+        this->remainingShipSizesKnown = enemyBoard.GetRemainingShipSizes(remainingShipSizes);
+        this->remainingShipsLeft = enemyBoard.GetShipsLeft();
+    }
+    BattleshipBoardView view;
+    view.board_size = enemyBoard.GetSize();
+    view.word_count = enemyBoard.GetAttackedPlane().GetWordCount();
+    view.attacked = enemyBoard.GetAttackedPlane().GetWords();
+    view.hit = enemyBoard.GetHitPlane().GetWords();
+    view.ships_left = enemyBoard.GetShipsLeft();
+    view.remaining_ship_sizes = remainingShipSizesKnown ? remainingShipSizes.data() : NULL;
+
+    int posIndex = api.choose_attack(bot, &view);
+    // An attack the game would refuse is replaced, so a faulty plugin can not stall the game.
+    if (posIndex < 0 || posIndex >= view.board_size*view.board_size || enemyBoard.HasBeenAttacked(posIndex)) {
+        return TakeRandomUnattacked(enemyBoard);
+    }
+    return posIndex;
+}
+
+void PluginStrategy::ReceiveAttackResult(int positionIndex, AttackResult result) {
+    if (api.attack_result) {
+        api.attack_result(bot, positionIndex, result);
+    }
+}
+
+bool isPluginPath(const string& name) {
+    return name.find('/') != string::npos || name.find('\\') != string::npos;
+}
+
+unique_ptr<Strategy> createStrategyOrPlugin(const string& name, uint64_t seed) {
+    if (!isPluginPath(name)) {
+        return createStrategy(name, seed);
+    }
+    try {
+        return unique_ptr<Strategy>(new PluginStrategy(loadStrategyPlugin(name), seed));
+    } catch (const char*) {
+        METRICS_COUNT(exceptionsCounter, 1);
+        return unique_ptr<Strategy>();
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef PLUGINSTRATEGY_HPP
+#define PLUGINSTRATEGY_HPP
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include "Board.hpp"
+#include "EnemyBoardView.hpp"
+#include "AttackResult.hpp"
+#include "Strategy.hpp"
+#include "BattleshipPlugin.h"
+
+using namespace std;
+
+// A strategy plugin loaded from a shared library (see `BattleshipPlugin.h`). Stays loaded while it is referenced.
+class StrategyPlugin {
+    private:
+        string path;
+        void* library;
+        const BattleshipPlugin* api;
+
+    public:
+        // Loads the library at `path`. Throws if it can not be loaded, is not a plugin or was built for another version.
+        StrategyPlugin(const string& path);
+        ~StrategyPlugin();
+        StrategyPlugin(const StrategyPlugin&) = delete;
+        StrategyPlugin& operator=(const StrategyPlugin&) = delete;
+
+        const string& GetPath() {return path;}
+        const BattleshipPlugin& GetApi() {return *api;}
+};
+
+// Returns the plugin at `path`, which is loaded only once per process. Throws like `StrategyPlugin`.
+shared_ptr<StrategyPlugin> loadStrategyPlugin(const string& path);
+
+// Lets a bot of a plugin play like any other strategy, in the same thread and without copying the enemy's board.
+// What the plugin leaves out (placing ships, or a valid attack) is done like `RandomStrategy` does.
+class PluginStrategy: public RandomStrategy {
+    private:
+        shared_ptr<StrategyPlugin> plugin;
+        const BattleshipPlugin& api;
+        void* bot;
+        // The sizes of the enemy's ships left, only asked for again when a ship was sunk.
+        vector<int> remainingShipSizes;
+        int remainingShipsLeft;
+        bool remainingShipSizesKnown;
+        vector<int> placements;
+        vector<int> positionIndices;
+
+    public:
+        PluginStrategy(shared_ptr<StrategyPlugin> plugin, uint64_t seed);
+        ~PluginStrategy();
+
+        void NewGame(int boardSize);
+        // Throws if the plugin places a ship where it does not fit.
+        void PlaceShips(Board& ownBoard, const vector<int>& shipSizes);
+        int ChooseAttack(const EnemyBoardView& enemyBoard);
+        void ReceiveAttackResult(int positionIndex, AttackResult result);
+};
+
+// Whether `name` is the path of a plugin rather than the name of a built in strategy, i.e. whether it has a '/'.
+bool isPluginPath(const string& name);
+// Like `createStrategy`, but also creates a strategy of the plugin at `name` if it is a path (e.g. "./parity.so").
+// Returns an empty pointer if there is no such strategy or the plugin can not be loaded.
+unique_ptr<Strategy> createStrategyOrPlugin(const string& name, uint64_t seed);
+
+#endif
@@ -9,25 +9,28 @@
 
 using namespace std;
 
+class Board;
+
+// A view of a single position on a board.
+// The state itself lives in the bit-planes of the board that handed out this view.
 class Position {
    private:
-      Ship* ship;
-      bool attacked;
-      bool recent;
+      Board* board;
+      int index;
 
    public:
-      Position();
+      Position(Board* board, int index);
       ~Position();
 
-      bool HasShip(); //{return this->hasShip;}
-      Ship* GetShip(); //{return *(this->ship);}
-      void SetShip(Ship *ship); //{this->ship = ship;}
-      bool HasBeenAttacked(); //{return this->attacked;}
-      bool HasBeenAttackedRecently(); //{return this->recent;}
+      int GetIndex(); //{return this->index;}
+      bool HasShip();
+      Ship* GetShip();
+      bool HasBeenAttacked();
+      bool HasBeenAttackedRecently();
 
       AttackResult GetAttacked();
       string PositionString(bool showShip);
     
 };
 
-#endif
\ No newline at end of file
+#endif
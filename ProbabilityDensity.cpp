@@ -0,0 +1,184 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <algorithm>
+#include "ProbabilityDensity.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DENSITY_SSE2
+#endif
+
+using namespace std;
+
+// Extra weight of a placement for every open hit it covers.
+// Placements through open hits are far more likely, so the player keeps shooting around a hit ship.
+const int16_t hitWeight = 24;
+
+ProbabilityDensity::ProbabilityDensity(int size) {
+    this->size = size;
+    // At least one padding column, so horizontal placements can not wrap onto the next row.
+    this->stride = GetStride(BoardDimension<0>(size));
+    free.assign(2*size*stride, 0);
+    openHits.assign(2*size*stride, 0);
+    attacked.assign(2*size*stride, 0);
+    density.assign(2*size*stride, 0);
+    weights.assign(size*stride, 0);
+    Clear();
+};
+ProbabilityDensity::~ProbabilityDensity() {};
+
+void ProbabilityDensity::Clear() {
+    fill(free.begin(), free.end(), 0);
+    fill(openHits.begin(), openHits.end(), 0);
+    fill(attacked.begin(), attacked.end(), 0);
+    for (int index=0; index<size*size; index++) {
+        free[ToCell(index)] = -1;
+    }
+}
+
+void ProbabilityDensity::MarkMiss(int index) {
+    int cell = ToCell(index);
+    free[cell] = 0;
+    attacked[cell] = 1;
+}
+
+void ProbabilityDensity::MarkHit(int index) {
+    int cell = ToCell(index);
+    openHits[cell] = 1;
+    attacked[cell] = 1;
+}
+
+void ProbabilityDensity::MarkSunk(int index) {
+    int cell = ToCell(index);
+    free[cell] = 0;
+    openHits[cell] = 0;
+    attacked[cell] = 1;
+}
+
+// Takes the longest line of open hits through the sinking attack, and the largest remaining ship that fits in it.
+void ProbabilityDensity::MarkSunkShip(int index, vector<int>& remainingShips) {
+    int x = index % size, y = index / size;
+    int bestStep = 1, bestBefore = 0, bestAfter = 0;
+    for (int step: {1, size}) {
+        int before = 0, after = 0;
+        if (step == 1) {
+            while (x-before-1 >= 0 && IsOpenHit(index - (before+1))) before++;
+            while (x+after+1 < size && IsOpenHit(index + (after+1))) after++;
+        } else {
+            while (y-before-1 >= 0 && IsOpenHit(index - (before+1)*step)) before++;
+            while (y+after+1 < size && IsOpenHit(index + (after+1)*step)) after++;
+        }
+        if (before + after > bestBefore + bestAfter) {
+            bestStep = step;
+            bestBefore = before;
+            bestAfter = after;
+        }
+    }
+
+    int length = bestBefore + bestAfter + 1;
+    int ship = -1;
+    for (size_t i=0; i<remainingShips.size(); i++) {
+        if (remainingShips[i] <= length && (ship < 0 || remainingShips[i] > remainingShips[ship])) {
+            ship = i;
+        }
+    }
+    int shipSize = 1;
+    if (ship >= 0) {
+        shipSize = remainingShips[ship];
+        remainingShips.erase(remainingShips.begin() + ship);
+    }
+
+    // The ship extends from the sinking attack towards the side with the most hits, staying within the line.
+    int last = bestAfter >= bestBefore ? min(bestAfter, shipSize-1) : shipSize-1 - min(bestBefore, shipSize-1);
+    for (int i=last-(shipSize-1); i<=last; i++) {
+        MarkSunk(index + i*bestStep);
+    }
+}
+
+// Adds every consistent placement of a ship to the density.
+// For every origin the placement weight is computed first, then added to the covered positions;
+// each pass is an element wise operation over the whole padded grid.
+template<class Dimension>
+void ProbabilityDensity::AddPlacements(Dimension dimension, int shipSize, bool vertical) {
+    const int stride = GetStride(dimension);
+    const int cells = dimension.GetSize()*stride;
+    const int step = vertical ? stride : 1;
+    int16_t* w = weights.data();
+    const int16_t* f = free.data();
+    const int16_t* h = openHits.data();
+    int16_t* d = density.data();
+#ifdef DENSITY_SSE2
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i weight = _mm_set1_epi16(hitWeight);
+    for (int cell=0; cell<cells; cell+=8) {
+        __m128i fits = _mm_loadu_si128((const __m128i*) (f + cell));
+        __m128i hits = _mm_loadu_si128((const __m128i*) (h + cell));
+        for (int k=1; k<shipSize; k++) {
+            fits = _mm_and_si128(fits, _mm_loadu_si128((const __m128i*) (f + cell + k*step)));
+            hits = _mm_add_epi16(hits, _mm_loadu_si128((const __m128i*) (h + cell + k*step)));
+        }
+        __m128i value = _mm_add_epi16(one, _mm_mullo_epi16(hits, weight));
+        _mm_storeu_si128((__m128i*) (w + cell), _mm_and_si128(fits, value));
+    }
+    for (int k=0; k<shipSize; k++) {
+        for (int cell=0; cell<cells; cell+=8) {
+            __m128i* target = (__m128i*) (d + cell + k*step);
+            __m128i sum = _mm_adds_epi16(_mm_loadu_si128(target), _mm_loadu_si128((const __m128i*) (w + cell)));
+            _mm_storeu_si128(target, sum);
+        }
+    }
+#else
+    for (int cell=0; cell<cells; cell++) {
+        int16_t fits = f[cell], hits = h[cell];
+        for (int k=1; k<shipSize; k++) {
+            fits &= f[cell + k*step];
+            hits += h[cell + k*step];
+        }
+        w[cell] = fits & (1 + hits*hitWeight);
+    }
+    for (int k=0; k<shipSize; k++) {
+        for (int cell=0; cell<cells; cell++) {
+            d[cell + k*step] = (int16_t) min(32767, d[cell + k*step] + w[cell]);
+        }
+    }
+#endif
+}
+
+template<class Dimension>
+void ProbabilityDensity::Compute(Dimension dimension, const vector<int>& shipSizes) {
+    fill(density.begin(), density.end(), 0);
+    for (int shipSize: shipSizes) {
+        AddPlacements(dimension, shipSize, false);
+        if (shipSize > 1) {
+            AddPlacements(dimension, shipSize, true);
+        }
+    }
+}
+
+void ProbabilityDensity::Compute(const vector<int>& shipSizes) {
+    dispatchBoardSize(size, [&](auto dimension) {Compute(dimension, shipSizes);});
+}
+
+template<class Dimension>
+int ProbabilityDensity::GetBestAttack(Dimension dimension) {
+    const int stride = GetStride(dimension);
+    int best = -1, bestDensity = -1;
+    for (int y=0; y<dimension.GetSize(); y++) {
+        for (int x=0; x<dimension.GetSize(); x++) {
+            int cell = y*stride + x;
+            if (!attacked[cell] && density[cell] > bestDensity) {
+                best = dimension.GetIndex(x, y);
+                bestDensity = density[cell];
+            }
+        }
+    }
+    return best;
+}
+
+int ProbabilityDensity::GetBestAttack() {
+    return dispatchBoardSize(size, [&](auto dimension) {return GetBestAttack(dimension);});
+}
@@ -0,0 +1,61 @@
+#ifndef PROBABILITYDENSITY_HPP
+#define PROBABILITYDENSITY_HPP
+#include <vector>
+#include <cstdint>
+#include "BoardDimension.hpp"
+
+using namespace std;
+
+// Counts, for every position of a board, how many placements of the remaining ships cover it
+// while being consistent with what is known about the board (misses, hits and sunk ships).
+// The position covered by the most placements is the most likely to hold a ship.
+//
+// Positions are stored in rows padded to a multiple of 8 and followed by as many empty rows,
+// so a placement at any origin can be checked with plain array offsets. Placements that leave
+// the board run into the padding, which is never free. The kernel then processes 8 origins at a
+// time with SSE2 when it is available. For the common board sizes the kernel is compiled for that size
+// (see `BoardDimension.hpp`).
+class ProbabilityDensity {
+    private:
+        int size, stride;
+        // -1 for positions where a ship could be, 0 otherwise (misses, sunk ships, padding).
+        vector<int16_t> free;
+        // 1 for hits that do not belong to a ship known to be sunk, 0 otherwise.
+        vector<int16_t> openHits;
+        vector<int16_t> attacked;
+        vector<int16_t> density;
+        // Scratch row with the weight of every placement being added.
+        vector<int16_t> weights;
+
+        int ToCell(int index) {return (index / size) * stride + index % size;}
+        template<class Dimension> static int GetStride(Dimension dimension) {return (dimension.GetSize() + 8) / 8 * 8;}
+        template<class Dimension> void AddPlacements(Dimension dimension, int shipSize, bool vertical);
+        template<class Dimension> void Compute(Dimension dimension, const vector<int>& shipSizes);
+        template<class Dimension> int GetBestAttack(Dimension dimension);
+
+    public:
+        ProbabilityDensity(int size);
+        ~ProbabilityDensity();
+
+        int GetSize() {return size;}
+
+        // Forgets all attacks.
+        void Clear();
+        void MarkMiss(int index);
+        void MarkHit(int index);
+        // Marks a hit position as part of a ship that is known to be sunk.
+        void MarkSunk(int index);
+        // Marks the ship sunk by the attack on a position as sunk, guessing its other positions and its size from the
+        // open hits, as the attacker is only told that a ship was sunk. Removes that size from `remainingShips`.
+        void MarkSunkShip(int index, vector<int>& remainingShips);
+        bool HasBeenAttacked(int index) {return attacked[ToCell(index)] != 0;}
+        bool IsOpenHit(int index) {return openHits[ToCell(index)] != 0;}
+
+        // Recounts the placements of the given ships.
+        void Compute(const vector<int>& shipSizes);
+        int GetDensity(int index) {return density[ToCell(index)];}
+        // Returns the position that was not attacked yet with the highest density, or -1 if there is none.
+        int GetBestAttack();
+};
+
+#endif
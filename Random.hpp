@@ -0,0 +1,57 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+#include <cstdint>
+
+using namespace std;
+
+// A small and fast pseudo random number generator (xoshiro256**).
+// Seedable so simulated games can be reproduced, unlike rand().
+class Random {
+    private:
+        uint64_t state[4];
+
+        static uint64_t RotateLeft(uint64_t x, int k) {return (x << k) | (x >> (64 - k));}
+
+    public:
+        Random(uint64_t seed = 0) {Seed(seed);}
+
+        // Fills the state from a single seed using splitmix64.
+        void Seed(uint64_t seed) {
+            for (int i=0; i<4; i++) {
+                seed += 0x9e3779b97f4a7c15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                state[i] = z ^ (z >> 31);
+            }
+        }
+
+        uint64_t Next() {
+            uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+            uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = RotateLeft(state[3], 45);
+            return result;
+        }
+
+        // Returns a uniformly distributed number in [0, bound).
+        // Uses Lemire's multiply and shift with rejection, so there is no modulo bias.
+        uint32_t NextBelow(uint32_t bound) {
+            uint64_t product = (uint64_t) (uint32_t) Next() * bound;
+            uint32_t low = (uint32_t) product;
+            if (low < bound) {
+                uint32_t threshold = (0u - bound) % bound;
+                while (low < threshold) {
+                    product = (uint64_t) (uint32_t) Next() * bound;
+                    low = (uint32_t) product;
+                }
+            }
+            return (uint32_t) (product >> 32);
+        }
+};
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef RULESET_HPP
+#define RULESET_HPP
+
+// In a classic game, each player attacks once per turn.
+// In a salvo game, each player attacks once per own ship that has not been sunk.
+enum Ruleset {classic, salvo};
+
+#endif
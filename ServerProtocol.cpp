@@ -0,0 +1,64 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include "ServerProtocol.hpp"
+
+using namespace std;
+
+int getRequestLength(const uint8_t* bytes, size_t available) {
+    if (available < 2) {
+        return available == 1 && (bytes[0] < createGame || bytes[0] > fire) ? -1 : 0;
+    }
+    int length;
+    switch (bytes[0]) {
+    case createGame:
+        length = 3;
+        break;
+    case joinGame:
+        length = 5;
+        break;
+    case placeFleet:
+        length = 2 + 3*bytes[1];
+        break;
+    case fire:
+        length = 2 + 2*bytes[1];
+        break;
+    default:
+        return -1;
+    }
+    return (size_t) length <= available ? length : 0;
+}
+
+int getResponseLength(const uint8_t* bytes, size_t available) {
+    if (available < 1) {
+        return 0;
+    }
+    int length;
+    switch (bytes[0]) {
+    case gameCreated:
+        length = 5;
+        break;
+    case gameJoined:
+        length = 4;
+        break;
+    case fleetPlaced:
+    case opponentLeft:
+        length = 1;
+        break;
+    case yourTurn:
+    case requestFailed:
+        length = 2;
+        break;
+    case fired:
+        if (available < 3) {
+            return 0;
+        }
+        length = 3 + 3*bytes[2];
+        break;
+    default:
+        return -1;
+    }
+    return (size_t) length <= available ? length : 0;
+}
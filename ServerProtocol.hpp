@@ -0,0 +1,45 @@
+#ifndef SERVERPROTOCOL_HPP
+#define SERVERPROTOCOL_HPP
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Messages between the game server and its clients (see `GameServer.hpp`).
+//
+// Every message is a type byte followed by a payload whose length follows from the type and its first byte,
+// so messages can be sent back to back without any framing. All numbers are little endian.
+//
+// Requests, from a client to the server:
+//   createGame  uint8 ruleset, uint8 board size
+//   joinGame    uint32 game id
+//   placeFleet  uint8 ship count, per ship uint16 first position and uint8 orientation (0 up, 1 down, 2 left, 3 right),
+//               in the order of the fleet of the server. A ship count of 0 lets the server place the fleet at random.
+//   fire        uint8 shot count, per shot uint16 position. As many shots as the last `yourTurn` asked for.
+//
+// Responses and events, from the server to a client:
+//   gameCreated   uint32 game id. The creator of a game is player 0.
+//   gameJoined    uint8 ruleset, uint8 board size, uint8 player. Sent to both players once the second player joined.
+//   fleetPlaced   no payload
+//   yourTurn      uint8 amount of shots to fire. Sent once both fleets are placed, and after every turn of the opponent.
+//   fired         uint8 player, uint8 shot count, per shot uint16 position and uint8 attack result.
+//                 Sent to both players after every turn. A `won` result ends the game.
+//   requestFailed uint8 request status
+//   opponentLeft  no payload. Ends the game.
+// After a game ends, a client can create or join the next one on the same connection.
+
+enum RequestType {createGame = 1, joinGame, placeFleet, fire};
+enum ResponseType {gameCreated = 1, gameJoined, fleetPlaced, yourTurn, fired, requestFailed, opponentLeft};
+
+// Why a request was refused.
+enum RequestStatus {accepted, badRequest, noSuchGame, alreadyInGame, notInGame, notYourTurn, illegalPlacement, illegalShots};
+
+// The largest message: a salvo of 255 shots with their results.
+const int maxMessageLength = 3 + 255*3;
+
+// Return the length of the request or response at the start of `bytes`, 0 if the first `available` bytes
+// do not hold all of it yet, or -1 if it is not a valid message.
+int getRequestLength(const uint8_t* bytes, size_t available);
+int getResponseLength(const uint8_t* bytes, size_t available);
+
+#endif
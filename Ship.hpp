@@ -23,7 +23,7 @@ class Ship {
         bool IsSunk();
 
         Ship(int size);
-        ~Ship();
+        ~Ship() = default;
 
 };
 
@@ -0,0 +1,55 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <typeinfo>
+#include "Simulation.hpp"
+#include "Board.hpp"
+#include "Strategy.hpp"
+#include "GameRules.hpp"
+
+using namespace std;
+
+Simulation::Simulation(Ruleset ruleset, int boardSize, vector<int> shipSizes)
+    : boardPlayerOne("Player one", boardSize), boardPlayerTwo("Player two", boardSize) {
+    this->ruleset = ruleset;
+    this->boardSize = boardSize;
+    this->shipSizes = shipSizes;
+    this->recorder = NULL;
+};
+Simulation::~Simulation() {};
+
+// Calls `play` with `strategy` as its own type if it is one of the built in strategies, or as a `Strategy` otherwise.
+// The type has to match exactly, since a subclass may replace any of the functions.
+template<typename Play>
+GameResult withStrategyType(Strategy& strategy, Play play) {
+    const type_info& type = typeid(strategy);
+    if (type == typeid(RandomStrategy)) {
+        return play(static_cast<RandomStrategy&>(strategy));
+    } else if (type == typeid(HuntTargetStrategy)) {
+        return play(static_cast<HuntTargetStrategy&>(strategy));
+    } else if (type == typeid(DensityStrategy)) {
+        return play(static_cast<DensityStrategy&>(strategy));
+    }
+    return play(strategy);
+}
+
+template<typename Rules>
+GameResult playWithStrategyTypes(Simulation& simulation, Strategy& playerOne, Strategy& playerTwo) {
+    return withStrategyType(playerOne, [&](auto& one) {
+        return withStrategyType(playerTwo, [&](auto& two) {
+            return simulation.Play<Rules>(one, two);
+        });
+    });
+}
+
+// The turn is compiled once per ruleset and pair of strategies, so playing a game costs two type checks
+// rather than a virtual call per shot.
+GameResult Simulation::Play(Strategy& playerOne, Strategy& playerTwo) {
+    if (ruleset == salvo) {
+        return playWithStrategyTypes<SalvoRules>(*this, playerOne, playerTwo);
+    }
+    return playWithStrategyTypes<ClassicRules>(*this, playerOne, playerTwo);
+}
@@ -0,0 +1,154 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+#include <vector>
+#include <string>
+#include <type_traits>
+#include "Board.hpp"
+#include "EnemyBoardView.hpp"
+#include "Strategy.hpp"
+#include "Ruleset.hpp"
+#include "GameRules.hpp"
+#include "GameRecord.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+// The outcome of a headless game.
+struct GameResult {
+    // 0 if player one won, 1 if player two won.
+    int winner;
+    // Amount of turns taken by both players together.
+    int turns;
+    // Amount of attacks made by each player.
+    int shots[2];
+    // Whether the loser gave up the game by attacking illegal positions, see `maxIllegalAttacks`.
+    bool forfeited;
+};
+
+/*******************************************************************
+                PLAYOUT
+********************************************************************/
+
+// Calls to a strategy of type `S` from a headless game. A strategy of a concrete type is called as that type rather
+// than through its virtual functions, so the compiler can inline it into the turn. The strategy must then be of
+// exactly that type, not a subclass of it. With `S` = `Strategy` the calls stay virtual, which fits any strategy.
+template<typename S>
+struct StrategyCalls {
+    static void NewGame(S& strategy, int boardSize) {
+        if constexpr (is_abstract<S>::value) strategy.NewGame(boardSize); else strategy.S::NewGame(boardSize);
+    }
+    static void PlaceShips(S& strategy, Board& ownBoard, const vector<int>& shipSizes) {
+        if constexpr (is_abstract<S>::value) strategy.PlaceShips(ownBoard, shipSizes); else strategy.S::PlaceShips(ownBoard, shipSizes);
+    }
+    static int ChooseAttack(S& strategy, const EnemyBoardView& enemyBoard) {
+        if constexpr (is_abstract<S>::value) return strategy.ChooseAttack(enemyBoard); else return strategy.S::ChooseAttack(enemyBoard);
+    }
+    static void ReceiveAttackResult(S& strategy, int positionIndex, AttackResult result) {
+        if constexpr (is_abstract<S>::value) strategy.ReceiveAttackResult(positionIndex, result); else strategy.S::ReceiveAttackResult(positionIndex, result);
+    }
+};
+
+// Plays one turn of the player `player` (0 or 1) with `strategy`. Returns 'true' if the game ended, either because
+// the player won or because they forfeited.
+template<typename Rules, typename S>
+bool playTurn(S& strategy, int player, Board& ownBoard, Board& enemyBoard, GameResult& result, GameRecorder* recorder) {
+    EnemyBoardView enemyView(&enemyBoard);
+    int attacks = Rules::GetShotsPerTurn(ownBoard, enemyBoard);
+    result.turns++;
+    METRICS_COUNT(turnsCounter, 1);
+    int illegalAttacks = 0;
+    for (int i=0; i<attacks; i++) {
+        int posIndex;
+        {
+            METRICS_TIME(decisionHistogram);
+            posIndex = StrategyCalls<S>::ChooseAttack(strategy, enemyView);
+        }
+        AttackResult attackResult = enemyBoard.GetAttacked(posIndex);
+        if (attackResult == alreadyAttacked) {
+            // Same as the interactive game: an illegal attack is simply retried, up to a point.
+            if (++illegalAttacks == maxIllegalAttacks) {
+                result.winner = !player;
+                result.forfeited = true;
+                return true;
+            }
+            i--;
+            continue;
+        }
+        result.shots[player]++;
+        if (recorder) {
+            recorder->AddShot(player, posIndex, attackResult);
+        }
+        StrategyCalls<S>::ReceiveAttackResult(strategy, posIndex, attackResult);
+        if (attackResult == won) {
+            result.winner = player;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Plays one complete game under `Rules` (see `GameRules.hpp`) on two boards, which are reset first.
+// Player one attacks first, like in the interactive game.
+template<typename Rules, typename PlayerOne, typename PlayerTwo>
+GameResult playGame(Board& boardPlayerOne, Board& boardPlayerTwo, const vector<int>& shipSizes,
+    PlayerOne& playerOne, PlayerTwo& playerTwo, GameRecorder* recorder) {
+    GameResult result = {-1, 0, {0, 0}, false};
+    int boardSize = boardPlayerOne.GetSize();
+    boardPlayerOne.Reset();
+    StrategyCalls<PlayerOne>::NewGame(playerOne, boardSize);
+    StrategyCalls<PlayerOne>::PlaceShips(playerOne, boardPlayerOne, shipSizes);
+    boardPlayerTwo.Reset();
+    StrategyCalls<PlayerTwo>::NewGame(playerTwo, boardSize);
+    StrategyCalls<PlayerTwo>::PlaceShips(playerTwo, boardPlayerTwo, shipSizes);
+    if (recorder) {
+        recorder->BeginGame(Rules::ruleset, boardPlayerOne, boardPlayerTwo);
+    }
+
+    while (!playTurn<Rules>(playerOne, 0, boardPlayerOne, boardPlayerTwo, result, recorder)
+        && !playTurn<Rules>(playerTwo, 1, boardPlayerTwo, boardPlayerOne, result, recorder)) {
+    }
+    METRICS_COUNT(gamesCounter, 1);
+    if (recorder) {
+        recorder->EndGame(result.winner);
+    }
+    return result;
+}
+
+/*******************************************************************
+                SIMULATION
+********************************************************************/
+
+// Plays complete games between two strategies without any input or output.
+// The attacks go through `Board::GetAttacked`, so the rules are the same as in the interactive game.
+// The boards are reset rather than reallocated between games.
+class Simulation {
+    private:
+        Ruleset ruleset;
+        int boardSize;
+        vector<int> shipSizes;
+        Board boardPlayerOne, boardPlayerTwo;
+        GameRecorder* recorder;
+
+    public:
+        Simulation(Ruleset ruleset, int boardSize, vector<int> shipSizes);
+        ~Simulation();
+
+        Ruleset GetRuleset() {return ruleset;}
+        int GetBoardSize() {return boardSize;}
+        const vector<int>& GetShipSizes() {return shipSizes;}
+        // Records every game played from now on with `recorder`, or stops recording if it is NULL.
+        void SetRecorder(GameRecorder* recorder) {this->recorder = recorder;}
+
+        // Plays one game. Player one attacks first, like in the interactive game.
+        // The built in strategies are recognized and played without virtual calls (see `StrategyCalls`).
+        GameResult Play(Strategy& playerOne, Strategy& playerTwo);
+
+        // Plays one game with the types of the strategies given, see `StrategyCalls`. The ruleset must be this
+        // simulation's; `Play` picks it.
+        template<typename Rules, typename PlayerOne, typename PlayerTwo>
+        GameResult Play(PlayerOne& playerOne, PlayerTwo& playerTwo) {
+            return playGame<Rules>(boardPlayerOne, boardPlayerTwo, shipSizes, playerOne, playerTwo, recorder);
+        }
+};
+
+#endif
@@ -0,0 +1,30 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <algorithm>
+#include "Snapshot.hpp"
+
+using namespace std;
+
+const char snapshotHeader[8] = {'B', 'S', 'S', 'N', 1, 0, 0, 0};
+// Boards are never larger anywhere in the game, and a damaged size should not make the reader allocate a huge board.
+const int maxSnapshotBoardSize = 100;
+
+void writeGameSnapshotHeader(ostream& out, const GameSnapshotHeader& header) {
+    out.write(snapshotHeader, sizeof(snapshotHeader));
+    out.write((const char*) &header, sizeof(header));
+}
+
+GameSnapshotHeader readGameSnapshotHeader(istream& in) {
+    char fileHeader[sizeof(snapshotHeader)];
+    GameSnapshotHeader header;
+    if (!in.read(fileHeader, sizeof(fileHeader)) || !equal(fileHeader, fileHeader + sizeof(fileHeader), snapshotHeader)
+        || !in.read((char*) &header, sizeof(header)) || header.ruleset > salvo
+        || header.boardSize < 1 || header.boardSize > maxSnapshotBoardSize) {
+        throw "This is not a game snapshot.";
+    }
+    return header;
+}
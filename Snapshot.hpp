@@ -0,0 +1,45 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+#include <iostream>
+#include <cstdint>
+#include "Ruleset.hpp"
+
+using namespace std;
+
+// Flat snapshots of boards and games, so that a game can be suspended to disk and resumed later.
+//
+// The arena of a board holds no pointers (ships are referred to by their index), so a board is saved by writing
+// the part of its arena in use as it is, and restored with a single read straight into the arena of a board of
+// the same size. Nothing is parsed per position. Snapshots are in the byte order of the machine that wrote them.
+//
+// A game snapshot is stored as (every part is a multiple of 8 bytes):
+//   8 bytes  "BSSN" 1 0 0 0
+//   GameSnapshotHeader
+//   the board snapshots of player one and player two
+// A board snapshot is stored as:
+//   BoardSnapshotHeader
+//   the player name, padded with zeros to a multiple of 8 bytes
+//   the first `arenaBytes` bytes of the arena: the bit-planes, the ship ids and the placed ships
+
+struct GameSnapshotHeader {
+    uint8_t ruleset;
+    uint8_t finished;
+    uint8_t playerTwoTurn;
+    uint8_t unused;
+    int32_t boardSize;
+};
+
+struct BoardSnapshotHeader {
+    int32_t size;
+    int32_t shipsLeft;
+    int32_t shipCount;
+    int32_t nameLength;
+    uint64_t arenaBytes;
+};
+
+void writeGameSnapshotHeader(ostream& out, const GameSnapshotHeader& header);
+// Reads the start of a game snapshot, up to the board snapshots. Throws if `in` does not hold a game snapshot,
+// or one of a board size that is not supported.
+GameSnapshotHeader readGameSnapshotHeader(istream& in);
+
+#endif
@@ -0,0 +1,85 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <string>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "Socket.hpp"
+
+using namespace std;
+
+// Fills in the socket address for `address` and returns its length.
+socklen_t getSocketAddress(const ServerAddress& address, sockaddr_storage& storage) {
+    memset(&storage, 0, sizeof(storage));
+    if (address.unixSocket) {
+        sockaddr_un* unixAddress = (sockaddr_un*) &storage;
+        if (address.path.empty() || address.path.size() >= sizeof(unixAddress->sun_path)) {
+            throw "The socket path is empty or too long.";
+        }
+        unixAddress->sun_family = AF_UNIX;
+        strcpy(unixAddress->sun_path, address.path.c_str());
+        return sizeof(sockaddr_un);
+    }
+    sockaddr_in* tcpAddress = (sockaddr_in*) &storage;
+    tcpAddress->sin_family = AF_INET;
+    tcpAddress->sin_port = htons(address.port);
+    tcpAddress->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return sizeof(sockaddr_in);
+}
+
+int listenAt(const ServerAddress& address) {
+    sockaddr_storage storage;
+    socklen_t length = getSocketAddress(address, storage);
+    int listenSocket = socket(storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenSocket < 0) {
+        throw "Could not create the listening socket.";
+    }
+    if (address.unixSocket) {
+        unlink(address.path.c_str());
+    } else {
+        int on = 1;
+        setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+    if (bind(listenSocket, (sockaddr*) &storage, length) < 0 || listen(listenSocket, SOMAXCONN) < 0) {
+        close(listenSocket);
+        throw "Could not listen at the given address.";
+    }
+    return listenSocket;
+}
+
+int connectTo(const ServerAddress& address) {
+    sockaddr_storage storage;
+    socklen_t length = getSocketAddress(address, storage);
+    int connection = socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (connection < 0 || connect(connection, (sockaddr*) &storage, length) < 0) {
+        if (connection >= 0) close(connection);
+        throw "Could not connect to the server.";
+    }
+    // Moves are small messages that should go out at once.
+    if (!address.unixSocket) {
+        int on = 1;
+        setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    fcntl(connection, F_SETFL, fcntl(connection, F_GETFL) | O_NONBLOCK);
+    return connection;
+}
+
+long raiseOpenFileLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 0;
+    }
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+    getrlimit(RLIMIT_NOFILE, &limit);
+    return limit.rlim_cur;
+}
@@ -0,0 +1,22 @@
+#ifndef SOCKET_HPP
+#define SOCKET_HPP
+#include <string>
+
+using namespace std;
+
+// Where the game server listens: a TCP port on the loopback address, or the path of a Unix domain socket.
+struct ServerAddress {
+    bool unixSocket;
+    int port;
+    string path;
+};
+
+// Opens a non-blocking socket listening at `address`. A Unix domain socket that is left over from an earlier run is replaced.
+// Throws if the address can not be used.
+int listenAt(const ServerAddress& address);
+// Opens a non-blocking connection to `address`. Throws if there is no server there.
+int connectTo(const ServerAddress& address);
+// Raises the limit on open files as far as allowed and returns it, so that many connections can be open at once.
+long raiseOpenFileLimit();
+
+#endif
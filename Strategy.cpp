@@ -0,0 +1,211 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include "Strategy.hpp"
+#include "Board.hpp"
+#include "Random.hpp"
+#include "ProbabilityDensity.hpp"
+#include "FleetGenerator.hpp"
+
+using namespace std;
+
+/*******************************************************************
+                RANDOM STRATEGY
+********************************************************************/
+
+RandomStrategy::RandomStrategy(uint64_t seed) : random(seed) {};
+RandomStrategy::~RandomStrategy() {};
+
+void RandomStrategy::NewGame(int boardSize) {
+    unattacked.resize(boardSize*boardSize);
+    for (int i=0; i<boardSize*boardSize; i++) {
+        unattacked[i] = i;
+    }
+}
+
+// The placement tables of the fleet generator are only built again when the board or the ships change.
+void RandomStrategy::PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+    if (!fleetGenerator || fleetGenerator->GetBoardSize() != ownBoard.GetSize() || fleetGenerator->GetShipSizes() != shipSizes) {
+        fleetGenerator.reset(new FleetGenerator(ownBoard.GetSize(), shipSizes));
+    }
+    fleetGenerator->Generate(random);
+    fleetGenerator->PlaceFleet(ownBoard, shipPositions);
+}
+
+// Removes and returns a random position that has not been attacked yet.
+// Positions attacked by other means are skipped when they come up.
+int RandomStrategy::TakeRandomUnattacked(const EnemyBoardView& enemyBoard) {
+    while (true) {
+        int i = random.NextBelow(unattacked.size());
+        int posIndex = unattacked[i];
+        unattacked[i] = unattacked.back();
+        unattacked.pop_back();
+        if (!enemyBoard.HasBeenAttacked(posIndex)) {
+            return posIndex;
+        }
+    }
+}
+
+int RandomStrategy::ChooseAttack(const EnemyBoardView& enemyBoard) {
+    return TakeRandomUnattacked(enemyBoard);
+}
+
+/*******************************************************************
+                HUNT/TARGET STRATEGY
+********************************************************************/
+
+HuntTargetStrategy::HuntTargetStrategy(uint64_t seed) : RandomStrategy(seed) {};
+HuntTargetStrategy::~HuntTargetStrategy() {};
+
+void HuntTargetStrategy::NewGame(int boardSize) {
+    RandomStrategy::NewGame(boardSize);
+    this->boardSize = boardSize;
+    targets.clear();
+}
+
+// Attacks the neighbours of earlier hits first, otherwise a random position.
+int HuntTargetStrategy::ChooseAttack(const EnemyBoardView& enemyBoard) {
+    while (!targets.empty()) {
+        int posIndex = targets.back();
+        targets.pop_back();
+        if (!enemyBoard.HasBeenAttacked(posIndex)) {
+            return posIndex;
+        }
+    }
+    return TakeRandomUnattacked(enemyBoard);
+}
+
+void HuntTargetStrategy::ReceiveAttackResult(int positionIndex, AttackResult result) {
+    if (result != hit) {
+        return;
+    }
+    int x = positionIndex % boardSize, y = positionIndex / boardSize;
+    if (x > 0) targets.push_back(positionIndex - 1);
+    if (x < boardSize-1) targets.push_back(positionIndex + 1);
+    if (y > 0) targets.push_back(positionIndex - boardSize);
+    if (y < boardSize-1) targets.push_back(positionIndex + boardSize);
+}
+
+/*******************************************************************
+                DENSITY STRATEGY
+********************************************************************/
+
+DensityStrategy::DensityStrategy(uint64_t seed) : RandomStrategy(seed), density(10), followsBoard(false) {};
+DensityStrategy::~DensityStrategy() {};
+
+void DensityStrategy::NewGame(int boardSize) {
+    RandomStrategy::NewGame(boardSize);
+    if (density.GetSize() != boardSize) {
+        density = ProbabilityDensity(boardSize);
+    }
+    density.Clear();
+    remainingShips.clear();
+    followsBoard = false;
+}
+
+// The enemy has the same ships as this player.
+void DensityStrategy::PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+    RandomStrategy::PlaceShips(ownBoard, shipSizes);
+    remainingShips.assign(shipSizes.begin(), shipSizes.end());
+    followsBoard = true;
+}
+
+// Catches up with a game that was resumed: the attacks made so far and the ships sunk and left are read from the view.
+// Which hits belong to the sunk ships is guessed with `ProbabilityDensity::MarkSunkShip`, as during a game, but from
+// the longest lines of hits rather than from the attacks that sank them, which the view does not tell.
+void DensityStrategy::ReadBoard(const EnemyBoardView& enemyBoard) {
+    density.Clear();
+    for (int i=0; i<enemyBoard.GetSize()*enemyBoard.GetSize(); i++) {
+        if (!enemyBoard.HasBeenAttacked(i)) {
+            continue;
+        }
+        if (enemyBoard.GetHitPlane().Test(i)) {
+            density.MarkHit(i);
+        } else {
+            density.MarkMiss(i);
+        }
+    }
+    // Every call marks at least one open hit as sunk, so this ends.
+    enemyBoard.GetSunkShipSizes(remainingShips);
+    int positionIndex;
+    while (!remainingShips.empty() && (positionIndex = FindOpenHitLineEnd()) >= 0) {
+        density.MarkSunkShip(positionIndex, remainingShips);
+    }
+    enemyBoard.GetRemainingShipSizes(remainingShips);
+    followsBoard = true;
+}
+
+// Returns an end of the longest line of open hits, or -1 if there are no open hits.
+int DensityStrategy::FindOpenHitLineEnd() {
+    int boardSize = density.GetSize();
+    int best = -1, bestLength = 0;
+    for (int i=0; i<boardSize*boardSize; i++) {
+        if (!density.IsOpenHit(i)) {
+            continue;
+        }
+        int x = i % boardSize, y = i / boardSize;
+        // Only the first position of a line is measured, towards the right and downwards.
+        int length = 0;
+        if (x == 0 || !density.IsOpenHit(i-1)) {
+            while (x+length < boardSize && density.IsOpenHit(i+length)) length++;
+        }
+        int verticalLength = 0;
+        if (y == 0 || !density.IsOpenHit(i-boardSize)) {
+            while (y+verticalLength < boardSize && density.IsOpenHit(i+verticalLength*boardSize)) verticalLength++;
+        }
+        length = max(length, verticalLength);
+        if (length > bestLength) {
+            best = i;
+            bestLength = length;
+        }
+    }
+    return best;
+}
+
+int DensityStrategy::ChooseAttack(const EnemyBoardView& enemyBoard) {
+    if (!followsBoard) {
+        ReadBoard(enemyBoard);
+    }
+    density.Compute(remainingShips);
+    int posIndex = density.GetBestAttack();
+    if (posIndex < 0 || enemyBoard.HasBeenAttacked(posIndex)) {
+        return TakeRandomUnattacked(enemyBoard);
+    }
+    return posIndex;
+}
+
+void DensityStrategy::ReceiveAttackResult(int positionIndex, AttackResult result) {
+    if (result == miss) {
+        density.MarkMiss(positionIndex);
+    } else {
+        density.MarkHit(positionIndex);
+        if (result == sunk || result == won) {
+            density.MarkSunkShip(positionIndex, remainingShips);
+        }
+    }
+}
+
+/*******************************************************************
+                STRATEGY REGISTRY
+********************************************************************/
+
+unique_ptr<Strategy> createStrategy(string name, uint64_t seed) {
+    if (name == "random") {
+        return unique_ptr<Strategy>(new RandomStrategy(seed));
+    } else if (name == "hunttarget") {
+        return unique_ptr<Strategy>(new HuntTargetStrategy(seed));
+    } else if (name == "density") {
+        return unique_ptr<Strategy>(new DensityStrategy(seed));
+    }
+    return unique_ptr<Strategy>();
+}
+
+vector<string> getStrategyNames() {
+    return {"random", "hunttarget", "density"};
+}
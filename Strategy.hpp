@@ -0,0 +1,91 @@
+#ifndef STRATEGY_HPP
+#define STRATEGY_HPP
+#include <vector>
+#include <string>
+#include <memory>
+#include "Board.hpp"
+#include "Bitboard.hpp"
+#include "EnemyBoardView.hpp"
+#include "AttackResult.hpp"
+#include "Random.hpp"
+#include "ProbabilityDensity.hpp"
+#include "FleetGenerator.hpp"
+
+using namespace std;
+
+// A programmatic player of a headless game.
+// A strategy places its own ships and picks the positions to attack on the enemy's board.
+class Strategy {
+    public:
+        virtual ~Strategy() {};
+
+        // Called before every game, before any ship is placed.
+        virtual void NewGame(int /*boardSize*/) {};
+        virtual void PlaceShips(Board& ownBoard, const vector<int>& shipSizes) = 0;
+        // Returns the index of the position to attack. Should not have been attacked before.
+        virtual int ChooseAttack(const EnemyBoardView& enemyBoard) = 0;
+        virtual void ReceiveAttackResult(int /*positionIndex*/, AttackResult /*result*/) {};
+};
+
+// Places ships in a uniformly random layout and attacks random positions that have not been attacked yet.
+class RandomStrategy: public Strategy {
+    protected:
+        Random random;
+        unique_ptr<FleetGenerator> fleetGenerator;
+        vector<int> unattacked;
+        vector<int> shipPositions;
+
+        int TakeRandomUnattacked(const EnemyBoardView& enemyBoard);
+
+    public:
+        RandomStrategy(uint64_t seed);
+        ~RandomStrategy();
+
+        void NewGame(int boardSize);
+        void PlaceShips(Board& ownBoard, const vector<int>& shipSizes);
+        int ChooseAttack(const EnemyBoardView& enemyBoard);
+};
+
+// Attacks random positions until a ship is hit, then attacks the neighbours of that hit.
+class HuntTargetStrategy: public RandomStrategy {
+    private:
+        int boardSize;
+        vector<int> targets;
+
+    public:
+        HuntTargetStrategy(uint64_t seed);
+        ~HuntTargetStrategy();
+
+        void NewGame(int boardSize);
+        int ChooseAttack(const EnemyBoardView& enemyBoard);
+        void ReceiveAttackResult(int positionIndex, AttackResult result);
+};
+
+// Attacks the position covered by the most placements of the remaining ships that fit the known hits and misses.
+class DensityStrategy: public RandomStrategy {
+    private:
+        ProbabilityDensity density;
+        vector<int> remainingShips;
+        // Whether `density` and `remainingShips` follow the enemy's board. Not so for a game that was resumed
+        // rather than started with `PlaceShips`, until they are read from the board.
+        bool followsBoard;
+
+        int FindOpenHitLineEnd();
+        void ReadBoard(const EnemyBoardView& enemyBoard);
+
+    public:
+        DensityStrategy(uint64_t seed);
+        ~DensityStrategy();
+
+        void NewGame(int boardSize);
+        void PlaceShips(Board& ownBoard, const vector<int>& shipSizes);
+        int ChooseAttack(const EnemyBoardView& enemyBoard);
+        void ReceiveAttackResult(int positionIndex, AttackResult result);
+};
+
+// Creates the strategy with the given name, or returns an empty pointer if there is no such strategy.
+unique_ptr<Strategy> createStrategy(string name, uint64_t seed);
+// Returns the names accepted by `createStrategy`.
+vector<string> getStrategyNames();
+
+#endif
@@ -0,0 +1,165 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include "Terminal.hpp"
+
+#ifdef __unix__
+#include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+
+#elif _WIN32
+#include <windows.h>
+#include <io.h>
+#include <conio.h>
+
+#endif
+
+using namespace std;
+
+static bool colorsSet = false;
+static bool handlersInstalled = false;
+#ifdef __unix__
+static bool rawMode = false;
+static struct termios savedMode;
+#endif
+
+// Restores the terminal and then lets the signal end the program as usual.
+static void restoreTerminalOnSignal(int signal) {
+    restoreTerminal();
+    ::signal(signal, SIG_DFL);
+    raise(signal);
+}
+
+static void restoreTerminalOnExit() {
+    cout << flush;
+    restoreTerminal();
+}
+
+// Makes sure the terminal is restored however the program ends.
+static void installHandlers() {
+    if (handlersInstalled) {
+        return;
+    }
+    handlersInstalled = true;
+    atexit(restoreTerminalOnExit);
+    signal(SIGINT, restoreTerminalOnSignal);
+    signal(SIGTERM, restoreTerminalOnSignal);
+#ifdef _WIN32
+    // Escape codes are only interpreted once virtual terminal processing is turned on.
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(output, &mode)) {
+        SetConsoleMode(output, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
+}
+
+bool isTerminalOutput() {
+#ifdef __unix__
+    return isatty(STDOUT_FILENO);
+#elif _WIN32
+    return _isatty(_fileno(stdout));
+#else
+    return false;
+#endif
+}
+
+bool isTerminalInput() {
+#ifdef __unix__
+    return isatty(STDIN_FILENO);
+#elif _WIN32
+    return _isatty(_fileno(stdin));
+#else
+    return false;
+#endif
+}
+
+int getTerminalRows() {
+    if (!isTerminalOutput()) {
+        return 0;
+    }
+#ifdef __unix__
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0) {
+        return size.ws_row;
+    }
+#elif _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        return info.srWindow.Bottom - info.srWindow.Top + 1;
+    }
+#endif
+    return 0;
+}
+
+void clearTerminal() {
+    if (!isTerminalOutput()) {
+        return;
+    }
+    installHandlers();
+    cout << "\033[2J\033[H" << flush;
+}
+
+void setTerminalColors() {
+    if (!isTerminalOutput()) {
+        return;
+    }
+    installHandlers();
+    colorsSet = true;
+    cout << "\033[32;40m" << flush;
+}
+
+// Switches the terminal to raw mode for a single key press, so the key is neither echoed nor needs 'enter'.
+void waitForKey() {
+    if (!isTerminalInput()) {
+        return;
+    }
+    installHandlers();
+    cout << "Press any key to continue..." << flush;
+#ifdef __unix__
+    if (tcgetattr(STDIN_FILENO, &savedMode) == 0) {
+        struct termios raw = savedMode;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        rawMode = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+        char key;
+        if (read(STDIN_FILENO, &key, 1) < 0) {
+            key = 0;
+        }
+        restoreTerminal();
+    }
+#elif _WIN32
+    _getch();
+#endif
+    cout << "\n";
+}
+
+// Only uses functions that are safe to call from a signal handler.
+void restoreTerminal() {
+#ifdef __unix__
+    if (rawMode) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &savedMode);
+        rawMode = false;
+    }
+    if (colorsSet) {
+        colorsSet = false;
+        if (write(STDOUT_FILENO, "\033[0m", 4) < 0) {
+            return;
+        }
+    }
+#elif _WIN32
+    if (colorsSet) {
+        colorsSet = false;
+        fputs("\033[0m", stdout);
+        fflush(stdout);
+    }
+#endif
+}
@@ -0,0 +1,26 @@
+#ifndef TERMINAL_HPP
+#define TERMINAL_HPP
+
+using namespace std;
+
+// Terminal control done within the process with ANSI escape codes, instead of starting a shell.
+// When standard output is not a terminal (e.g. when the game is driven by a script),
+// all screen control is skipped and only the text of the game is written.
+
+// Returns 'true' if standard output is a terminal.
+bool isTerminalOutput();
+// Returns 'true' if standard input is a terminal.
+bool isTerminalInput();
+// Returns the amount of rows of the terminal, or 0 if it is not known.
+int getTerminalRows();
+
+// Clears the terminal and moves the cursor to the top left.
+void clearTerminal();
+// Green text on a black background. The colors are reset when the program exits.
+void setTerminalColors();
+// Waits until any key is pressed, without needing 'enter'. Does not wait when input is not a terminal.
+void waitForKey();
+// Undoes every change made to the terminal. Called automatically on exit and on interrupts.
+void restoreTerminal();
+
+#endif
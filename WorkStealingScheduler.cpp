@@ -0,0 +1,67 @@
+/*
+C++ Battleship Game
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <vector>
+#include <thread>
+#include <mutex>
+#include "WorkStealingScheduler.hpp"
+
+using namespace std;
+
+WorkStealingScheduler::WorkStealingScheduler(int workerCount) : queues(workerCount > 0 ? workerCount : 1) {
+    this->workerCount = queues.size();
+    this->nextQueue = 0;
+};
+WorkStealingScheduler::~WorkStealingScheduler() {};
+
+void WorkStealingScheduler::AddTask(Task task) {
+    WorkerQueue& queue = queues[nextQueue];
+    nextQueue = (nextQueue + 1) % workerCount;
+    lock_guard<mutex> guard(queue.lock);
+    queue.tasks.push_back(task);
+}
+
+// Takes the next task of a worker's own queue, or steals one from another worker.
+// Returns 'false' when there is no work left anywhere.
+bool WorkStealingScheduler::TakeTask(int worker, Task& task) {
+    {
+        WorkerQueue& own = queues[worker];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (int i=1; i<workerCount; i++) {
+        WorkerQueue& victim = queues[(worker + i) % workerCount];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingScheduler::RunWorker(int worker) {
+    Task task;
+    while (TakeTask(worker, task)) {
+        task(worker);
+    }
+}
+
+// Tasks never add new tasks, so a worker that finds every queue empty can stop.
+void WorkStealingScheduler::Run() {
+    vector<thread> threads;
+    for (int worker=1; worker<workerCount; worker++) {
+        threads.push_back(thread(&WorkStealingScheduler::RunWorker, this, worker));
+    }
+    RunWorker(0);
+    for (thread& t: threads) {
+        t.join();
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef WORKSTEALINGSCHEDULER_HPP
+#define WORKSTEALINGSCHEDULER_HPP
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+
+using namespace std;
+
+// Runs a fixed set of tasks on a number of worker threads.
+// Every worker has its own queue and takes work from the back of it. A worker that runs out of
+// work steals from the front of another worker's queue, so long tasks do not leave cores idle.
+class WorkStealingScheduler {
+    public:
+        // A task gets the index of the worker running it, so it can use per worker state.
+        typedef function<void(int worker)> Task;
+
+    private:
+        struct WorkerQueue {
+            mutex lock;
+            deque<Task> tasks;
+        };
+
+        int workerCount, nextQueue;
+        vector<WorkerQueue> queues;
+
+        bool TakeTask(int worker, Task& task);
+        void RunWorker(int worker);
+
+    public:
+        WorkStealingScheduler(int workerCount);
+        ~WorkStealingScheduler();
+
+        int GetWorkerCount() {return workerCount;}
+
+        // Adds a task. Tasks are spread over the worker queues in turn.
+        void AddTask(Task task);
+        // Runs all added tasks and returns once they are all done.
+        void Run();
+};
+
+#endif
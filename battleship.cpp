@@ -6,26 +6,31 @@ Author: Enrique Dehaerne
 #include <iostream>
 #include <vector>
 #include <string>
-#include<dos.h>
-#include <conio.h>
 #include <chrono>
 #include <thread>
 #include <map>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <future>
+#include <ctime>
 #include <math.h>
 #include "Game.hpp"
 #include "Board.hpp"
 #include "Position.hpp"
 #include "Ship.hpp"
+#include "BoardRenderer.hpp"
+#include "Terminal.hpp"
+#include "GameRecord.hpp"
+#include "Snapshot.hpp"
+#include "Player.hpp"
+#include "Strategy.hpp"
+#include "PluginStrategy.hpp"
+#include "EnemyBoardView.hpp"
+#include "BotProtocol.hpp"
+#include "Metrics.hpp"
 
 
-#ifdef __unix__  
-#include <unistd.h>
-
-#elif _WIN32
-#include <synchapi.h>
-
-#endif
-
 using namespace std;
 
 // Early declaration of some helper functions
@@ -33,188 +38,16 @@ string getHitString();
 string getMissString();
 string getSunkString();
 string getWonString();
+string getShortResultString(AttackResult attackResult);
 int getAttackPositionFromPlayer(int boardSize);
 void clear();
 void pause();
 
 /*******************************************************************
-                SHIP CLASS
-********************************************************************/
-
-// A ship that is placed on board positions.
-Ship::Ship(int size){
-    this->size = size;
-    this->hp = size;
-};
-Ship::~Ship() {};
-
-bool Ship::IsSunk(){return this->hp == 0;}
-
-// Get hit by an attack. Lowers the ship's HP and returns an Attack result.
-AttackResult Ship::GetHit() {
-    this->hp --;
-    if (IsSunk()) {
-        return sunk;
-    } else {
-        return hit;
-    }
-}
-
-/*******************************************************************
-                POSITION CLASS
-********************************************************************/
-
-// A position on a board. May have a ship placed on it.
-Position::Position() {
-   this->attacked=false;
-   this->recent=false;
-   this->ship=NULL;
-};
-Position::~Position() {};
-
-bool Position::HasShip(){return this->ship != NULL;}
-void Position::SetShip(Ship* ship){this->ship = ship;};
-bool Position::HasBeenAttacked(){return this->attacked;}
-bool Position::HasBeenAttackedRecently(){return this->recent;}
-
-// Prints a string representing the state of this position.
-// Modifies the 'recent' attribute of the position when a full turn has passed.
-string Position::PositionString(bool showShip) {
-    if (HasShip()) {
-        string posLine = "| ";
-        if (showShip) {
-            posLine += "{";
-        } else {
-            posLine +=" ";
-        }
-        if (HasBeenAttacked()) {
-            if (HasBeenAttackedRecently()) {
-                posLine += "#";
-                recent = showShip;
-            } else {
-                posLine += "X";
-            }
-        } else {
-            posLine += " ";
-        }
-        if (showShip) {
-            posLine += "} ";
-        } else {
-            posLine +="  ";
-        }
-        return posLine;
-    } else {
-        string posLine = "| ";
-        posLine += " ";
-        if (HasBeenAttacked()) {
-            if (HasBeenAttackedRecently()) {
-                posLine += "@";
-                recent = showShip;
-            } else {
-                posLine += "O";
-            }
-        } else {
-            posLine += " ";
-        }
-        posLine +=  "  ";
-        return posLine;
-    }
-}
-
-// Get attacked. Marks the position as attacked recently.
-AttackResult Position::GetAttacked() {
-    if (HasBeenAttacked()) {
-        throw "You have already attacked this position! Please give another position to attack.";
-    } else if (HasShip()) {
-        attacked = true;
-        recent = true;
-        return ship->GetHit();
-    } else {
-        attacked = true;
-        recent = true;
-        return miss;
-    }
-}
-
-
-/*******************************************************************
-                BOARD CLASS
+                GAME CLASS - TERMINAL OUTPUT
 ********************************************************************/
 
-// A board that belongs to a player of a battleship game.
-// A board has an array of positions of size
-Board::Board(string playerName, int size){
-    this->playerName = playerName;
-    this->positions = {};
-    for (int i=0; i<size*size;i++) {
-        this->positions.push_back(new Position());
-    };
-    this->shipsLeft=0;
-};
-Board::~Board(){};
-
-Position* Board::GetPosition(int index) {
-    return (this->positions[index]);}
-int Board::GetShipsLeft(){return this->shipsLeft;};
-string Board::GetPlayerName(){return this->playerName;};
-
-// Prints a board of a given size using pre made strings. 
-// Will print ships or not depending on the given `showShips` argument.
-void Board::PrintBoard(int size, bool showShips, map<int,string> preMadeStrings) {
-    string board = preMadeStrings[2] + preMadeStrings[1] + "0 ";
-    for (int i=0;i<size*size;i++) {
-        if (i % size == 0 && i != 0) {
-            board += "|\n" + preMadeStrings[4] +  to_string((int) floor(i/size)) + " ";
-        };
-        board += GetPosition(i)->PositionString(showShips);
-    };
-
-    board += "|\n";
-    board += preMadeStrings[3];
-    cout << board;
-}
-
-// Place a ship on the board on the given position indices.
-void Board::PlaceShip(vector<int> positionIndices, int shipSize) {
-    Ship* newShip = new Ship(shipSize);
-    this->shipsLeft ++;
-    for (int posIn: positionIndices) {
-        GetPosition(posIn)->SetShip(newShip);
-    }
-}
-
-// Get attacked on a certain position with given posIndex.
-AttackResult Board::GetAttacked(int posIndex) {
-    AttackResult result =  GetPosition(posIndex)->GetAttacked();
-    if (result == sunk) {
-        this->shipsLeft --;
-        if (shipsLeft == 0) {
-            return won;
-        }
-    }
-    return result;
-}
-
-
-/*******************************************************************
-                GAME CLASS
-********************************************************************/
-
-// A battleship game. Should be either a 'ClassicGame' or 'SalvoGame' derived class.
-// This class has methods and attributes inherited by those derived classes.
-Game::Game(int boardSize) {
-    this->boardSize = boardSize;
-    this->boardPlayerOne = NULL;
-    this->boardPlayerTwo = NULL;
-    this->finished = false;
-}
-Game::~Game() {}
-
-void Game::SetBoardPlayerOne(Board* boardPlayerOne){this->boardPlayerOne = boardPlayerOne;}
-void Game::SetBoardPlayerTwo(Board* boardPlayerTwo){this->boardPlayerTwo = boardPlayerTwo;}
-vector<AttackResult> Game::GetTurnResult() {return turnResult;}
-void Game::AddTurnResult(AttackResult attackResult){this->turnResult.push_back (attackResult);}
-bool Game::HasFinished(){return finished;}
+// The rules of the game are in `Game.cpp`; only what the game prints lives here.
 
 void Game::PrintAttackResult(AttackResult attackResult) {
     switch (attackResult)
@@ -238,22 +71,22 @@ void Game::PrintAttackResult(AttackResult attackResult) {
     }
 }
 
-void Game::AttackHelper(Board*ownBoard, Board* enemyBoard) {
-     int coordinates = getAttackPositionFromPlayer(boardSize);
-    try {
-        this->AddTurnResult(enemyBoard->GetAttacked(coordinates));
-    } catch( const char* e) {
-        cerr << e;
-        this->AttackHelper(ownBoard,enemyBoard);
-    }
-}
-
 // Prints the result of the last turn completed.
-void Game::DisplayTurnResult(Board* ownBoard, Board* enemyBoard) {
-    clear();
-    cout  << ownBoard->GetPlayerName() << "'s turn result(s): \n\n";
-    for(AttackResult res:turnResult) {
-        PrintAttackResult(res);
+// With `belowBoards` the screen is not cleared: the results are printed on one line below the boards, which stay
+// on the screen, so they fit in the rows left below the boards.
+void Game::DisplayTurnResult(Board* ownBoard, Board* enemyBoard, bool belowBoards) {
+    if (belowBoards) {
+        cout << ownBoard->GetPlayerName() << "'s turn result(s):";
+        for(AttackResult res:turnResult) {
+            cout << " " << getShortResultString(res);
+        }
+        cout << "\n";
+    } else {
+        clear();
+        cout  << ownBoard->GetPlayerName() << "'s turn result(s): \n\n";
+        for(AttackResult res:turnResult) {
+            PrintAttackResult(res);
+        }
     }
     this->turnResult.clear();
     if (!finished) {
@@ -263,53 +96,21 @@ void Game::DisplayTurnResult(Board* ownBoard, Board* enemyBoard) {
     
 }
 
-SalvoGame::SalvoGame(int boardSize) : Game(boardSize) {};
-SalvoGame::~SalvoGame() {};
-
-// Prompts the player for coordinates to attack a position on the enemy's board.
-// For a salvo game, the player can attack as many positions as the player has ships that have not been sunk.
-// Modifies the position attacked as well as the ship on the position if there is one.
-void SalvoGame::Attack(Board* ownBoard, Board* enemyBoard) {
-    cout << ownBoard->GetPlayerName() << ", your turn to attack " << enemyBoard->GetPlayerName() <<"!\n";
-    cout << "You have " << ownBoard->GetShipsLeft() << " ships left so you can attack the same amount of coordinates.\n";
-    for (int i=0; i<ownBoard->GetShipsLeft(); i++) {
-        AttackHelper(ownBoard,enemyBoard);
-    }
-};
-
-ClassicGame::ClassicGame(int boardSize) : Game(boardSize) {};
-ClassicGame::~ClassicGame(){};
-
-// Prompts the player for coordinates to attack a position on the enemy's board.
-// Modifies the position attacked as well as the ship on the position if there is one.
-void ClassicGame::Attack(Board* ownBoard, Board* enemyBoard) {
-    cout << ownBoard->GetPlayerName() << ", your turn to attack " << enemyBoard->GetPlayerName() <<"!";
-    AttackHelper(ownBoard, enemyBoard);
-};
-
 
 /*******************************************************************
                 HELPER FUNCTIONS
 ********************************************************************/
 
 // Pauses program execution until a key is pressed by the user.
-// This function will print "Please enter any key to continue...".
+// This function will print "Press any key to continue...".
 void pause() {
-    #ifdef __unix__
-        system("read");
-    #elif _WIN32
-        system("pause");
-    #endif
+    waitForKey();
 }
 
 // Clears the terminal
 void clear()
 {
-#if defined _WIN32
-    system("cls");
-#elif __unix__
-    system("clear");
-#endif
+    clearTerminal();
 }
 
 string getTitleString() {
@@ -369,44 +170,21 @@ string getWonString() {
     return won;
 }
 
-string getTopLineString(int size) {
-    string line = "Y ";
-    for(int i=0; i<size; i++) {
-        line += "------"; 
+string getShortResultString(AttackResult attackResult) {
+    switch (attackResult) {
+    case miss:
+        return "Miss!";
+    case hit:
+        return "Hit!";
+    case sunk:
+        return "Sunk!";
+    case won:
+        return "Won!";
+    default:
+        throw "Could not identify attack result...";
     }
-    line += "-\n";
-    return line;
 }
 
-string getXAxisString(int size) {
-    string axis = "  X";
-    for (int i=0; i<size; i++) {
-        axis += "  ";
-        axis += to_string(i);
-        axis += "   ";
-    };
-    axis += "\n";
-    return axis;
-}
-
-string getBottomLineString(int size) {
-    string line = "  ";
-    for(int i=0; i<size; i++) {
-        line +="------";
-    }
-    line += "-\n";
-    return line;
-};
-
-string getIntermediateLineString(int size) {
-    string line = "  |";
-    for(int i=0; i<size; i++) {
-        line += "- - - ";
-    }
-    line += "\b|\n";
-    return line;
-};
-
 // Prompts the user to pick between a 'classic' or a 'salvo' game mode.
 // In the classic game mode, each user only attacks once during their turn.
 // In the salvo game mode, each user can attack as many times as they have ships that have not been sunk.
@@ -428,55 +206,13 @@ bool isLegalOrientationInput(int orientation) {
     return orientation != 0 || orientation != 1 || orientation != 2 || orientation != 3 || orientation != 4; 
 }
 
-// Checks to see if the positions intended for a ship fall within the game board.
-bool isLegalInitPositionAndOrientation(int x, int y, int orientation, int shipSize, int boardSize) {
-    if (orientation == 0) { // up
-        return y >= shipSize-1;
-    } else if (orientation ==1){ //down
-        return y + shipSize <= boardSize;
-    } else if (orientation ==2) { //left
-        return x >= shipSize-1;
-    } else { // right
-        return x + shipSize <= boardSize;
-    }   
-}
-
-// Calculates positions for a ship based on an intial position and an orientation.
-vector<int> getShipPositions(int initIndex, int orientation, int shipSize, int boardSize, Board& board) {
-    vector<int> positionIndices {initIndex};
-    // Get positions based on initIndex and orientation
-    if (orientation == 0) { // up
-        for(int i=boardSize; i<shipSize*boardSize; i+=boardSize) {
-            positionIndices.push_back(initIndex-i);
-        }
-    } else if (orientation ==1){ //down
-        for(int i=boardSize; i<shipSize*boardSize; i+=boardSize) {
-            positionIndices.push_back(initIndex+i);
-        }
-    } else if (orientation ==2) { //left
-        for(int i=1; i<shipSize; i++) {
-            positionIndices.push_back(initIndex-i);
-        }
-    } else { // right
-        for(int i=1; i<shipSize; i++) {
-            positionIndices.push_back(initIndex+i);
-        }
-    }
-    // Make sure there are no ships in the positions calculated above.
-    for (int posIndex: positionIndices) {
-        if(board.GetPosition(posIndex)->HasShip()) {
-            throw "There is already a ship in at least one of the positions that a new ship is attempting to be placed.\nPlease retry placing this ship...";
-        }
-    }
-    return positionIndices;   
-}
-
 // Prompts the player for the positions that a ship should be placed.
 // The positions are calculated from getting an initial position and an orientation that the ship grows from that position.
 vector<int> getShipPositioningFromPlayer(int shipSize, int boardSize, Board& board) {
     int x = -1, y = -1, initIndex, orientation=-1;
     bool properInitCoordinates = false, properOrientation=false;
     vector<int> newShipPositionIndices;
+    METRICS_TIME(inputWaitHistogram);
     
     while(!properOrientation) {
         while(!properInitCoordinates) {
@@ -494,7 +230,7 @@ vector<int> getShipPositioningFromPlayer(int shipSize, int boardSize, Board& boa
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
             initIndex = x+y*boardSize;
-            if (board.GetPosition(initIndex)->HasShip()) {
+            if (board.HasShip(initIndex)) {
                 cout << "This position already has a ship! Please place the ship in an empty position...";
             } else {
                 properInitCoordinates = true;
@@ -511,15 +247,15 @@ vector<int> getShipPositioningFromPlayer(int shipSize, int boardSize, Board& boa
         if (orientation == 4) {
             cout << "Reseting initial position...";
             properInitCoordinates=false;
-        } else if (isLegalInitPositionAndOrientation(x,y,orientation,shipSize,boardSize)) {
-            try {
-                newShipPositionIndices = getShipPositions(initIndex, orientation, shipSize, boardSize, board);
+        } else {
+            PlacementResult placementResult = getShipPositions(initIndex, orientation, shipSize, boardSize, board, newShipPositionIndices);
+            if (placementResult == placed) {
                 properOrientation = true;
-            } catch (const char* e) {
-                cout << e;
+            } else if (placementResult == overlap) {
+                cout << "There is already a ship in at least one of the positions that a new ship is attempting to be placed.\nPlease retry placing this ship...";
+            } else {
+                cout << "Illegal ship positioning, please try another orientation... ";
             }
-        } else {
-            cout << "Illegal ship positioning, please try another orientation... ";
         }
     }
     return newShipPositionIndices;
@@ -528,6 +264,7 @@ vector<int> getShipPositioningFromPlayer(int shipSize, int boardSize, Board& boa
 // Prompts the player for the coordinates to attack.
 int getAttackPositionFromPlayer(int boardSize) {
     int x=-1, y=-1;
+    METRICS_TIME(inputWaitHistogram);
     cout << "\nWhich coordinates would you like to attack?";
     cout << "\nX: ";
     while(!(cin >> x) || (x <0 || x>boardSize-1)) {
@@ -544,16 +281,286 @@ int getAttackPositionFromPlayer(int boardSize) {
     return x+y*boardSize;
 }
 
+/*******************************************************************
+                TERMINAL PLAYER
+********************************************************************/
+
+// A person at the terminal. The answers are typed in before a request returns, so they are always ready right away.
+class TerminalPlayer: public Player {
+    private:
+        BoardRenderer& renderer;
+        Ruleset ruleset;
+
+    public:
+        TerminalPlayer(BoardRenderer& renderer, Ruleset ruleset) : renderer(renderer), ruleset(ruleset) {}
+
+        // Prompts for the position of every ship, one at a time, showing the board as it fills up.
+        future<void> PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+            bool firstShip = true;
+            for(int shipSize: shipSizes) {
+            if (firstShip || !renderer.CanUpdateInPlace(1)) {
+                clear();
+                cout << ownBoard.GetPlayerName() + ", please position your ships now: \n\n";
+                renderer.Invalidate(3);
+                firstShip = false;
+            }
+            renderer.Draw(0, ownBoard, true);
+            renderer.MoveBelowBoards();
+            vector<int> newShipPositionIndices = getShipPositioningFromPlayer(shipSize,ownBoard.GetSize(),ownBoard);
+            ownBoard.PlaceShip(newShipPositionIndices, shipSize);
+            }
+            return makeReadyFuture();
+        }
+
+        // Prompts for coordinates to attack positions on the enemy's board.
+        // All coordinates of a salvo are asked first, then the salvo is fired at once.
+        future<vector<int>> ChooseAttack(Board& ownBoard, const EnemyBoardView& enemyBoard, int count) {
+            cout << ownBoard.GetPlayerName() << ", your turn to attack " << enemyBoard.GetPlayerName() <<"!";
+            if (ruleset == salvo) {
+                cout << "\nYou have " << ownBoard.GetShipsLeft() << " ships left so you can attack the same amount of coordinates.\n";
+            }
+            vector<int> salvo;
+            while ((int) salvo.size() < count) {
+                int coordinates = getAttackPositionFromPlayer(enemyBoard.GetSize());
+                if (enemyBoard.HasBeenAttacked(coordinates) || find(salvo.begin(), salvo.end(), coordinates) != salvo.end()) {
+                    METRICS_COUNT(invalidAttacksCounter, 1);
+                    cerr << "You have already attacked this position! Please give another position to attack.";
+                } else {
+                    salvo.push_back(coordinates);
+                }
+            }
+            return makeReadyFuture(salvo);
+        }
+};
+
+/*******************************************************************
+                BOT PROTOCOL
+********************************************************************/
+
+// Both players of a game of the bot protocol (see `BotProtocol.hpp`): every move is a command from standard input,
+// and every command is answered on standard output.
+class ProtocolPlayer: public Player {
+    private:
+        LineReader& reader;
+        BotWriter& writer;
+        BotCommand command;
+        vector<int> positionIndices;
+        // Results still to come for the last FIRE command.
+        int pendingResults;
+        bool newGame;
+
+        // Reads the next command, answering any command of another type with an error.
+        // Throws at the end of the input, and when a new game is started.
+        void ReadCommand(BotCommandType type) {
+            const char* begin, * end;
+            while (reader.ReadLine(begin, end)) {
+                if (parseBotCommand(begin, end, command) && command.type == type) {
+                    return;
+                }
+                if (command.type == gameCommand) {
+                    newGame = true;
+                    throw "A new game was started in the middle of a game.";
+                }
+                writer.Write(command.type == invalidCommand ? "ERR syntax\n" : "ERR unexpected\n");
+            }
+            throw "The commands ended in the middle of a game.";
+        }
+
+    public:
+        ProtocolPlayer(LineReader& reader, BotWriter& writer) : reader(reader), writer(writer), pendingResults(0), newGame(false) {}
+
+        // Returns 'true' once if the last game ended because of a GAME command, which is then stored in `gameCommand`.
+        bool TakeNewGame(BotCommand& gameCommand) {
+            if (!newGame) {
+                return false;
+            }
+            newGame = false;
+            gameCommand = command;
+            return true;
+        }
+
+        future<void> PlaceShips(Board& ownBoard, const vector<int>& shipSizes) {
+            int boardSize = ownBoard.GetSize();
+            for (int shipSize: shipSizes) {
+                while (true) {
+                    ReadCommand(placeCommand);
+                    PlacementResult result = offBoard;
+                    if (command.x >= 0 && command.x < boardSize && command.y >= 0 && command.y < boardSize) {
+                        result = getShipPositions(command.x + command.y*boardSize, command.orientation, shipSize, boardSize, ownBoard, positionIndices);
+                    }
+                    if (result == placed) {
+                        break;
+                    }
+                    writer.Write("ERR ");
+                    writer.Write(getPlacementResultWord(result));
+                    writer.Write('\n');
+                }
+                ownBoard.PlaceShip(positionIndices, shipSize);
+                writer.Write("OK\n");
+            }
+            return makeReadyFuture();
+        }
+
+        future<vector<int>> ChooseAttack(Board& /*ownBoard*/, const EnemyBoardView& enemyBoard, int count) {
+            int boardSize = enemyBoard.GetSize();
+            vector<int> salvo;
+            while (true) {
+                ReadCommand(fireCommand);
+                const char* error = NULL;
+                salvo.clear();
+                if ((int) command.coordinates.size() != 2*count) {
+                    error = "ERR count\n";
+                }
+                for (size_t i=0; !error && i<command.coordinates.size(); i+=2) {
+                    int x = command.coordinates[i], y = command.coordinates[i+1];
+                    if (x < 0 || x >= boardSize || y < 0 || y >= boardSize) {
+                        error = "ERR offboard\n";
+                    } else if (enemyBoard.HasBeenAttacked(x + y*boardSize) || find(salvo.begin(), salvo.end(), x + y*boardSize) != salvo.end()) {
+                        error = "ERR attacked\n";
+                    }
+                    salvo.push_back(x + y*boardSize);
+                }
+                if (!error) {
+                    break;
+                }
+                METRICS_COUNT(invalidAttacksCounter, 1);
+                writer.Write(error);
+            }
+            pendingResults = count;
+            return makeReadyFuture(salvo);
+        }
+
+        // The results of a salvo are answered together on one line.
+        void ReceiveAttackResult(int /*positionIndex*/, AttackResult result) {
+            writer.Write(getAttackResultWord(result));
+            writer.Write(--pendingResults > 0 ? ' ' : '\n');
+        }
+};
+
+// Plays the games of the commands on standard input, answering on standard output, until the input ends.
+// A GAME command in the middle of a game starts a new one; any other command outside a game is refused.
+void playBotProtocol(const vector<int>& defaultShipSizes) {
+    BotWriter writer(1);
+    LineReader reader(0, &writer);
+    ProtocolPlayer player(reader, writer);
+    BotCommand command;
+    const char* begin, * end;
+    bool haveCommand = false;
+    while (haveCommand || reader.ReadLine(begin, end)) {
+        if (!haveCommand && (!parseBotCommand(begin, end, command) || command.type != gameCommand)) {
+            writer.Write(command.type == invalidCommand ? "ERR syntax\n" : "ERR unexpected\n");
+            continue;
+        }
+        haveCommand = false;
+        const vector<int>& shipSizes = command.shipSizes.empty() ? defaultShipSizes : command.shipSizes;
+        if (!isPlayableGame(command.boardSize, shipSizes)) {
+            writer.Write("ERR size\n");
+            continue;
+        }
+        writer.Write("OK\n");
+        int boardSize = command.boardSize;
+        unique_ptr<Game> game(command.ruleset == salvo ? (Game*) new SalvoGame(boardSize) : (Game*) new ClassicGame(boardSize));
+        Board boardOne("one", boardSize), boardTwo("two", boardSize);
+        game->SetBoardPlayerOne(&boardOne);
+        game->SetBoardPlayerTwo(&boardTwo);
+        game->SetPlayers(&player, &player);
+        try {
+            while (!game->PlaceShips(shipSizes)) {
+                game->WaitForPlayer();
+            }
+            while (!game->HasFinished()) {
+                while (!game->Attack()) {
+                    game->WaitForPlayer();
+                }
+                game->EndTurn();
+            }
+        } catch (const char* e) {
+            METRICS_COUNT(exceptionsCounter, 1);
+            // Either a new game starts, or the input ended.
+            haveCommand = player.TakeNewGame(command);
+            if (!haveCommand) {
+                return;
+            }
+        }
+    }
+}
+
 /*******************************************************************
                 MAIN
 ********************************************************************/
 
-int main() {
+int main(int argc, char* argv[]) {
 
     /// Game parameters
     int gameBoardSize = 10;
     vector<int> shipSizes {5,4,3,3,2};
 
+    // With `--record FILE` the game is saved to FILE in the game record format (see `GameRecord.hpp`).
+    // With `--save FILE` a snapshot of the game (see `Snapshot.hpp`) is saved to FILE after every turn,
+    // and `--resume FILE` continues the game of such a snapshot.
+    // With `--computer STRATEGY` player two is played by one of the strategies of the headless games,
+    // or by a strategy plugin if STRATEGY is the path of one (see `BattleshipPlugin.h`).
+    // With `--protocol` the games are played with commands instead of prompts (see `BotProtocol.hpp`).
+    // With `--metrics TARGET` the metrics of a build with them (see `Metrics.hpp`) are written to TARGET every few seconds.
+    string recordPath, savePath, resumePath, computerName, metricsTarget;
+    bool protocol = false, validArguments = true;
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--protocol") {
+            protocol = true;
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--save" && hasValue) {
+            savePath = argv[++i];
+        } else if (arg == "--resume" && hasValue) {
+            resumePath = argv[++i];
+        } else if (arg == "--computer" && hasValue && createStrategyOrPlugin(argv[i+1], 0)) {
+            computerName = argv[++i];
+        } else if (arg == "--metrics" && hasValue) {
+            metricsTarget = argv[++i];
+        } else {
+            validArguments = false;
+        }
+    }
+    // A record holds the whole game, so a resumed game can not be recorded.
+    // With commands, the games and players come from the commands.
+    if (!validArguments || (!recordPath.empty() && !resumePath.empty())
+        || (protocol && (!recordPath.empty() || !savePath.empty() || !resumePath.empty() || !computerName.empty()))) {
+        cout << "Usage: battleship [--record FILE | --resume FILE] [--save FILE] [--computer STRATEGY] [--metrics TARGET]\n"
+            << "       battleship --protocol [--metrics TARGET]\nStrategies:";
+        for (string name: getStrategyNames()) {
+            cout << " " << name;
+        }
+        cout << ", or the path of a plugin\n";
+        return 1;
+    }
+    unique_ptr<MetricsReporter> metricsReporter;
+    if (!metricsTarget.empty()) {
+        if (!hasMetrics()) {
+            cerr << "This build has no metrics, build it with -DBATTLESHIP_METRICS to have them.\n";
+            return 1;
+        }
+        metricsReporter.reset(new MetricsReporter(metricsTarget, 5.0));
+    }
+    if (protocol) {
+        playBotProtocol(shipSizes);
+        return 0;
+    }
+    ifstream resumeFile;
+    GameSnapshotHeader resumeHeader;
+    if (!resumePath.empty()) {
+        resumeFile.open(resumePath, ios::binary);
+        try {
+            resumeHeader = readGameSnapshotHeader(resumeFile);
+        } catch (const char* e) {
+            METRICS_COUNT(exceptionsCounter, 1);
+            cerr << resumePath << ": " << e << endl;
+            return 1;
+        }
+        gameBoardSize = resumeHeader.boardSize;
+    }
+
     int gameShipAmount = shipSizes.size();
 
     // vars used for printing game boards
@@ -572,72 +579,140 @@ int main() {
 
     // Clear and color terminal.
     clear();
-    system("Color 0A");
+    setTerminalColors();
     
     cout << getTitleString();
     cout << "Welcome to battleship! Let's set up your game...\n\n";
 
-    // Get player names.
     string playerOne, playerTwo;
-    cout << "Player one's name: ";
-    cin >> playerOne;
-    cout << "Player two's name: ";
-    cin >> playerTwo;
-
-    // Choose game type.
-    int gameType = getGameFromPlayer();
     Game* game;
     ClassicGame classicGame = ClassicGame(gameBoardSize);
     SalvoGame salvoGame = SalvoGame(gameBoardSize);
-    if (gameType<0.5) {
-        cout << "\nYou chose: Classic Game.\n\nNext we will set up your boards.\n";
-            game = &classicGame;
-    } else if (gameType>0.5) {
-        cout << "\nYou chose: Salvo Game.\n\nNext we will set up your boards.\n";
-            game = &salvoGame;
+    if (resumePath.empty()) {
+        // Get player names.
+        cout << "Player one's name: ";
+        cin >> playerOne;
+        if (computerName.empty()) {
+            cout << "Player two's name: ";
+            cin >> playerTwo;
+        } else {
+            playerTwo = computerName;
+        }
+
+        // Choose game type.
+        int gameType = getGameFromPlayer();
+        if (gameType<0.5) {
+            cout << "\nYou chose: Classic Game.\n\nNext we will set up your boards.\n";
+                game = &classicGame;
+        } else if (gameType>0.5) {
+            cout << "\nYou chose: Salvo Game.\n\nNext we will set up your boards.\n";
+                game = &salvoGame;
+        }
+    } else if (resumeHeader.ruleset == salvo) {
+        game = &salvoGame;
+    } else {
+        game = &classicGame;
     }
-    pause();
 
     /// Setup boards
    
     // Init boards.
-    vector<Board*> boards = {new Board(playerOne, gameBoardSize), new Board(playerTwo, gameBoardSize)};
-    // Iterate over every ship to allow the user to position a ship one at a time on their board.
-    for (Board* board: boards) {
-        for(int shipSize: shipSizes) {
+    Board boardOne(playerOne, gameBoardSize), boardTwo(playerTwo, gameBoardSize);
+    vector<Board*> boards = {&boardOne, &boardTwo};
+    game->SetBoardPlayerOne(boards[0]);
+    game->SetBoardPlayerTwo(boards[1]);
+    // Boards are redrawn in place where possible, so only positions that changed are written.
+    BoardRenderer renderer(gameBoardSize, boardPrintStrings, cout);
+    GameRecorder recorder;
+    TerminalPlayer terminalPlayer(renderer, game->GetRuleset());
+    unique_ptr<Player> computerPlayer;
+    if (!computerName.empty()) {
+        computerPlayer.reset(new StrategyPlayer(createStrategyOrPlugin(computerName, time(NULL)), gameBoardSize, time(NULL)));
+    }
+    game->SetPlayers(&terminalPlayer, computerPlayer ? computerPlayer.get() : &terminalPlayer);
+    if (resumePath.empty()) {
+        pause();
+        // Every player positions their ships on their own board.
+        while (!game->PlaceShips(shipSizes)) {
+            game->WaitForPlayer();
+        }
+        if (!recordPath.empty()) {
+            recorder.BeginGame(game->GetRuleset(), boardOne, boardTwo);
+            game->SetRecorder(&recorder);
+        }
         clear();
-        cout << board->GetPlayerName() + ", please position your ships now: \n\n";
-        board->PrintBoard(gameBoardSize, true, boardPrintStrings);
-        vector<int> newShipPositionIndices = getShipPositioningFromPlayer(shipSize,gameBoardSize,*board);
-        board->PlaceShip(newShipPositionIndices, shipSize);
+        cout << "\nBoth boards are now set up, " << boards[0]->GetPlayerName() << " will attack first." << endl;
+    } else {
+        // The names, ships and attacks all come from the snapshot.
+        try {
+            game->LoadSnapshot(resumeHeader, resumeFile);
+        } catch (const char* e) {
+            METRICS_COUNT(exceptionsCounter, 1);
+            cerr << resumePath << ": " << e << endl;
+            return 1;
         }
+        cout << "\nResuming the game of " << boards[0]->GetPlayerName() << " and " << boards[1]->GetPlayerName() << ", "
+            << boards[game->IsPlayerTwoTurn()]->GetPlayerName() << " is up next." << endl;
     }
-    // Set the boards with ships
-    game->SetBoardPlayerOne(boards[0]);
-    game->SetBoardPlayerTwo(boards[1]);
-    clear();
-    cout << "\nBoth boards are now set up, " << boards[0]->GetPlayerName() << " will attack first." << endl;
     pause();
 
 
     /// Take turns attacking
 
-    bool playerTwoTurn = false;
+    // Against the computer the same player always looks at the same boards, so they are kept on the screen and
+    // every turn only redraws the positions attacked since. Between two players the screen is cleared for every
+    // turn, so neither sees the ships of the other.
+    bool boardsOnScreen = false;
+    // Rows the prompts of a turn take below the boards: the greeting, and three per position attacked.
+    int turnPromptRows = 3 + 3*(game->GetRuleset() == salvo ? gameShipAmount : 1);
     while(!game->HasFinished()) {
 
-        Board* ownBoard = boards[playerTwoTurn];
-        Board* enemyBoard = boards[!playerTwoTurn];
+        Board* ownBoard = boards[game->IsPlayerTwoTurn()];
+        Board* enemyBoard = boards[!game->IsPlayerTwoTurn()];
+        bool keepBoards = computerPlayer && renderer.CanUpdateInPlace(2, turnPromptRows);
         
-        clear();
-        enemyBoard->PrintBoard(gameBoardSize,false,boardPrintStrings);
-        ownBoard->PrintBoard(gameBoardSize,true,boardPrintStrings);
-        game->Attack(ownBoard,enemyBoard);
-        game->DisplayTurnResult(ownBoard, enemyBoard);
+        // The boards of the computer are not shown, so its ships stay hidden.
+        if (!computerPlayer || !game->IsPlayerTwoTurn()) {
+            if (!keepBoards || !boardsOnScreen) {
+                clear();
+                renderer.Invalidate(1);
+            }
+            renderer.Draw(0, *enemyBoard, false);
+            renderer.Draw(1, *ownBoard, true);
+            renderer.MoveBelowBoards();
+            boardsOnScreen = keepBoards;
+        }
+        while (!game->Attack()) {
+            game->WaitForPlayer();
+        }
+        if (keepBoards && boardsOnScreen) {
+            renderer.ClearBelowBoards();
+        } else {
+            boardsOnScreen = false;
+        }
+        game->DisplayTurnResult(ownBoard, enemyBoard, boardsOnScreen);
         
-        playerTwoTurn = !playerTwoTurn;
+        game->EndTurn();
+        if (!savePath.empty()) {
+            ofstream snapshotFile(savePath, ios::binary | ios::trunc);
+            game->SaveSnapshot(snapshotFile);
+            if (!snapshotFile) {
+                cerr << "Could not save the game to " << savePath << endl;
+            }
+        }
+    }
+    // The player who attacked last has won, unless they forfeited.
+    bool playerTwoWon = game->IsPlayerTwoTurn() == game->HasForfeited();
+    cout << "Congratulations " << boards[playerTwoWon]->GetPlayerName() << ", you won!" << endl;
+    if (!recordPath.empty()) {
+        recorder.EndGame(playerTwoWon);
+        ofstream recordFile(recordPath, ios::binary | ios::trunc);
+        writeGameRecordFileHeader(recordFile);
+        recorder.Flush(recordFile);
+        if (!recordFile) {
+            cerr << "Could not save the game to " << recordPath << endl;
+        }
     }
-    // Player has won.
-    cout << "Congratulations " << boards[!playerTwoTurn]->GetPlayerName() << ", you won!" << endl;
 
     return 0;
 };
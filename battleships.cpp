@@ -6,49 +6,77 @@ Written by:  Shivam Shekhar
 #include<stdio.h>
 #include<iostream>
 #include<time.h>
+#include<vector>
+#include<algorithm>
+#include<string.h>
+#include "ProbabilityDensity.hpp"
+#include "FrameScheduler.hpp"
+#include "FleetGenerator.hpp"
+#include "Random.hpp"
 
 using namespace std;
 
-void delay(clock_t a)
+FrameScheduler scheduler;
+
+/*Waits the given amount of milliseconds by sleeping, not by spinning on the clock*/
+void delay(int milliseconds)
 {
-    clock_t start;
-    start  = clock();
-    while(clock()-start<a)
-    {
+    scheduler.Wait(milliseconds);
+}
 
+/*Schedules a string to be typed one character every 60 ms, starting at the given time. Returns when typing ends.*/
+int typeString(const char *str,int start)
+{
+    int i;
+    for(i=0;str[i]!='\0';i++)
+    {
+        scheduler.After(start+60*(i+1),[=]()
+        {
+            printf("%c",str[i]);
+            fflush(stdout);
+        });
     }
+    return start+60*i;
 }
-int main()
+
+/*Index of a ship in the hit point arrays, from the letter it is marked with on the grids*/
+int shipindex(char ship)
+{
+    return ship=='A' ? 0 : ship=='B' ? 1 : ship=='D' ? 2 : 3;
+}
+
+/*Pass --no-delays to skip all waiting, e.g. for automated runs*/
+int main(int argc,char *argv[])
 {
     //A:Aircraft carrier
     //B:Battleship
     //D:destroyer
     //C:corvette
-    int i,j,k=0,x,y,chk=0,win=0,uposa[5][2],uposb[4][2],uposd[3][2],uposc[2][2],a=0,b=0,c=0,d=0,probab,diff;
+    int i,j,k,x,y,chk=0,probab,diff;
+    /*Sizes of the A, B, D and C ships, and the hits each ship and fleet can still take.
+      Sinking and winning are decided from these instead of by counting hits on the grids.*/
+    int shipsize[4]={5,4,3,2},cpuhp[4],userhp[4],cpuships=0,userships=0;
     char gridu[10][10],griduv[10][10],gridc[10][10],gridcv[10][10],orin[2],tempstr[10],str[20]="Battleships V1.0",str1[50]="Written By: Shivam Shekhar",ch;
-   for(i=0;i<10;i++)
-    {
-        printf("\n");
-    }
-    for(i=0;i<30;i++)
+    for(i=1;i<argc;i++)
     {
-        printf(" ");
+        if(strcmp(argv[i],"--no-delays")==0)
+            scheduler.SetNoDelays(true);
     }
-    for(i=0;str[i]!='\0';i++)
+   for(i=0;i<10;i++)
     {
-        printf("%c",str[i]);
-        delay(60);
+        printf("\n");
     }
-    printf("\n");
     for(i=0;i<30;i++)
     {
         printf(" ");
     }
-    for(i=0;str1[i]!='\0';i++)
+    k=typeString(str,0);
+    scheduler.After(k,[]()
     {
-        printf("%c",str1[i]);
-        delay(60);
-    }
+        printf("\n%30s","");
+    });
+    k=typeString(str1,k);
+    scheduler.RunUntilIdle();
     delay(1500);
     system("cls");
     for(;;)
@@ -153,9 +181,6 @@ int main()
                 for(i=y;i<y+5;i++)
                 {
                     gridu[x][i]='A';
-                    uposa[k][0]=x;
-                    uposa[k][1]=i;
-                    k++;
                 }
                 break;
             }
@@ -172,15 +197,11 @@ int main()
                 for(i=x;i<x+5;i++)
                 {
                     gridu[i][y]='A';
-                    uposa[k][0]=i;
-                    uposa[k][1]=y;
-                    k++;
                 }
                 break;
             }
         }
     }
-    k=0;
     system("cls");
     for(i=0;i<10;i++)
     {
@@ -235,9 +256,6 @@ int main()
                     for(i=y;i<y+4;i++)
                     {
                         gridu[x][i]='B';
-                        uposb[k][0]=x;
-                        uposb[k][1]=i;
-                        k++;
                     }
                     break;
                 }
@@ -268,16 +286,12 @@ int main()
                    for(i=x;i<x+4;i++)
                     {
                         gridu[i][y]='B';
-                        uposb[k][0]=i;
-                        uposb[k][1]=y;
-                        k++;
                     }
                     break;
                 }
             }
         }
     }
-    k=0;
     system("cls");
     for(i=0;i<10;i++)
     {
@@ -331,9 +345,6 @@ int main()
                     for(i=y;i<y+3;i++)
                     {
                         gridu[x][i]='D';
-                        uposd[k][0]=x;
-                        uposd[k][1]=i;
-                        k++;
                     }
                     break;
                 }
@@ -364,16 +375,12 @@ int main()
                     for(i=x;i<x+3;i++)
                     {
                         gridu[i][y]='D';
-                        uposd[k][0]=i;
-                        uposd[k][1]=y;
-                        k++;
                     }
                     break;
                 }
             }
         }
     }
-    k=0;
     system("cls");
     for(i=0;i<10;i++)
     {
@@ -427,9 +434,6 @@ int main()
                     for(i=y;i<y+2;i++)
                     {
                         gridu[x][i]='C';
-                        uposc[k][0]=x;
-                        uposc[k][1]=i;
-                        k++;
                     }
                     break;
                 }
@@ -460,9 +464,6 @@ int main()
                     for(i=x;i<x+2;i++)
                     {
                         gridu[i][y]='C';
-                        uposc[k][0]=i;
-                        uposc[k][1]=y;
-                        k++;
                     }
                     break;
                 }
@@ -492,223 +493,18 @@ int main()
     fflush(stdin);
     gets(tempstr);
     srand(time(NULL));
-    /*Aircraft carrier cpu*/
-    for(;;)
+    /*Computer's ships: every layout of the fleet is equally likely*/
     {
-        if(rand()%2 == 1)
-            strcpy(orin,"h");
-        else strcpy(orin,"v");
-        x=rand()%10;
-        y=rand()%10;
-        if(strcmp(orin,"h")==0)
+        Random random(time(NULL));
+        FleetGenerator fleet(10,vector<int>(shipsize,shipsize+4));
+        const char shipletter[4]={'A','B','D','C'};
+        const int *positions;
+        fleet.Generate(random);
+        for(k=0;k<4;k++)
         {
-            if(y>5 || y<0 || x>9 || x<0)
-            {
-                continue;
-            }
-            else
-            {
-                for(i=y;i<y+5;i++)
-                    gridc[x][i]='A';
-                break;
-            }
-        }
-        if(strcmp(orin,"v")==0)
-        {
-            if(x>5 || x<0 || y>9 || y<0)
-            {
-                continue;
-            }
-             else
-            {
-                for(i=x;i<x+5;i++)
-                    gridc[i][y]='A';
-                break;
-            }
-        }
-    }
-    /*B:Battleship cpu*/
-    for(;;)
-    {
-        chk=0;
-        if(rand()%2 == 1)
-            strcpy(orin,"h");
-        else strcpy(orin,"v");
-        x=rand()%10;
-        y=rand()%10;
-        if(strcmp(orin,"h")==0)
-        {
-            if(y>6 || y<0 || x>9 || x<0)
-                continue;
-            else
-            {
-                for(i=y;i<y+4;i++)
-                {
-                    if(gridc[x][i]!='.')
-                    {
-                        chk=1;
-                        break;
-                    }
-                }
-                if(chk==1)
-                    continue;
-                else
-                {
-                    for(i=y;i<y+4;i++)
-                        gridc[x][i]='B';
-                    break;
-                }
-            }
-        }
-        if(strcmp(orin,"v")==0)
-        {
-            if(x>6 || x<0 || y>9 || y<0)
-            {
-                continue;
-            }
-             else
-            {
-                 for(i=x;i<x+4;i++)
-                {
-                    if(gridc[i][y]!='.')
-                    {
-                        chk=1;
-                        break;
-                    }
-                }
-                if(chk==1)
-                    continue;
-                else
-                {
-                    for(i=x;i<x+4;i++)
-                        gridc[i][y]='B';
-                    break;
-                }
-            }
-        }
-    }
-    /*Destroyer cpu*/
-    for(;;)
-    {
-        chk=0;
-        if(rand()%2 == 1)
-            strcpy(orin,"h");
-        else strcpy(orin,"v");
-        x=rand()%10;
-        y=rand()%10;
-        if(strcmp(orin,"h")==0)
-        {
-            if(y>7 || y<0 || x>9 || x<0)
-            {
-               continue;
-            }
-            else
-            {
-                for(i=y;i<y+3;i++)
-                {
-                    if(gridc[x][i]!='.')
-                    {
-                        chk=1;
-                        break;
-                    }
-                }
-                if(chk==1)
-                    continue;
-                else
-                {
-                    for(i=y;i<y+3;i++)
-                        gridc[x][i]='D';
-                    break;
-                }
-            }
-        }
-        if(strcmp(orin,"v")==0)
-        {
-            if(x>7 || x<0 || y>9 || y<0)
-            {
-                continue;
-            }
-             else
-            {
-                 for(i=x;i<x+3;i++)
-                {
-                    if(gridc[i][y]!='.')
-                    {
-                        chk=1;
-                        break;
-                    }
-                }
-                if(chk==1)
-                    continue;
-                else
-                {
-                    for(i=x;i<x+3;i++)
-                        gridc[i][y]='D';
-                    break;
-                }
-            }
-        }
-    }
-    /*Corvette cpu*/
-    for(;;)
-    {
-        chk=0;
-        if(rand()%2 == 1)
-            strcpy(orin,"h");
-        else strcpy(orin,"v");
-        x=rand()%10;
-        y=rand()%10;
-        if(strcmp(orin,"h")==0)
-        {
-            if(y>8 || y<0 || x>9 || x<0)
-            {
-                continue;
-            }
-            else
-            {
-                for(i=y;i<y+2;i++)
-                {
-                    if(gridc[x][i]!='.')
-                    {
-                        chk=1;
-                        break;
-                    }
-                }
-                if(chk==1)
-                    continue;
-                else
-                {
-                    for(i=y;i<y+2;i++)
-                        gridc[x][i]='C';
-                    break;
-                }
-            }
-        }
-        if(strcmp(orin,"v")==0)
-        {
-            if(x>8 || x<0 || y>9 || y<0)
-            {
-                continue;
-            }
-             else
-            {
-                 for(i=x;i<x+2;i++)
-                {
-                    if(gridc[i][y]!='.')
-                    {
-                        chk=1;
-                        break;
-                    }
-                }
-                if(chk==1)
-                    continue;
-                else
-                {
-                    for(i=x;i<x+2;i++)
-                        gridc[i][y]='C';
-                    break;
-                }
-            }
+            positions=fleet.GetShipPositions(k);
+            for(i=0;i<shipsize[k];i++)
+                gridc[positions[i]/10][positions[i]%10]=shipletter[k];
         }
     }
    /* system("cls");
@@ -733,6 +529,16 @@ int main()
         for(j=0;j<10;j++)
             griduv[i][j]=gridu[i][j];
     }
+    for(i=0;i<4;i++)
+    {
+        cpuhp[i]=shipsize[i];
+        userhp[i]=shipsize[i];
+        cpuships++;
+        userships++;
+    }
+    /*What the computer knows about the player's grid*/
+    ProbabilityDensity ai(10);
+    vector<int> aiships(shipsize,shipsize+4);
     for(;;)
     {
         system("cls");
@@ -789,6 +595,10 @@ int main()
                     if(gridcv[x][y]!='H')
                     {
                         gridcv[x][y]='H';
+                        k=shipindex(gridc[x][y]);
+                        cpuhp[k]--;
+                        if(cpuhp[k]==0)
+                            cpuships--;
                         system("cls");
                         for(i=0;i<10;i++)
                         {
@@ -827,20 +637,11 @@ int main()
                                 printf("%c ",griduv[i][j]);
                             printf("\n");
                         }
-                        for(i=0;i<10;i++)
-                        {
-                            for(j=0;j<10;j++)
-                            {
-                                if(gridcv[i][j]=='H')
-                                    win++;
-                            }
-                        }
-                        if(win==14)
+                        if(cpuships==0)
                         {
                             printf("\nYou win!\n");
                             break;
                         }
-                        win=0;
                         continue;
                     }
                     else
@@ -856,37 +657,24 @@ int main()
                 }
             }
         }
+        if(cpuships==0)
+            break;
         for(;;)
         {
+            /*The computer only knows its own hits and misses. It fires where most placements of the
+              ships it has not sunk yet fit, and on easier levels sometimes fires at random instead.*/
             probab=rand()%diff;
-            if(probab==diff-3&& a<5)
-            {
-                x=uposa[a][0];
-                y=uposa[a][1];
-                a++;
-            }
-            else if(probab==diff-2 && b<4)
-            {
-                x=uposb[b][0];
-                y=uposb[b][1];
-                b++;
-            }
-            else if(probab==diff-5 && d<3)
-            {
-                x=uposd[d][0];
-                y=uposd[d][1];
-                d++;
-            }
-            else if(probab==diff-6 && c<2)
+            if(probab<diff-6)
             {
-                x=uposc[c][0];
-                y=uposc[c][1];
-                c++;
+                x=rand()%10;
+                y=rand()%10;
             }
             else
             {
-                x=rand()%10;
-                y=rand()%10;
+                ai.Compute(aiships);
+                k=ai.GetBestAttack();
+                x=k/10;
+                y=k%10;
             }
             if(x>9 || x<0 || y>9 || y<0 || griduv[x][y]=='H' || griduv[x][y]=='*')
             {
@@ -899,6 +687,15 @@ int main()
                     if(griduv[x][y]!='H')
                     {
                         griduv[x][y]='H';
+                        ai.MarkHit(x*10+y);
+                        /*Tell the computer when it sinks a ship, but not which one: it guesses that from its hits*/
+                        ch=gridu[x][y];
+                        userhp[shipindex(ch)]--;
+                        if(userhp[shipindex(ch)]==0)
+                        {
+                            userships--;
+                            ai.MarkSunkShip(x*10+y,aiships);
+                        }
                         system("cls");
                         for(i=0;i<10;i++)
                         {
@@ -938,6 +735,8 @@ int main()
                             printf("\n");
                         }
                         delay(1000);
+                        if(userships==0)
+                            break;
                         continue;
                     }
                     else
@@ -948,39 +747,17 @@ int main()
                 else
                 {
                     griduv[x][y]='*';
+                    ai.MarkMiss(x*10+y);
                     break;
                 }
             }
 
         }
-        for(i=0;i<10;i++)
-        {
-            for(j=0;j<10;j++)
-            {
-                if(gridcv[i][j]=='H')
-                    win++;
-            }
-        }
-        if(win==14)
-        {
-            printf("\nYou win!\n");
-            break;
-        }
-        win=0;
-        for(i=0;i<10;i++)
-        {
-            for(j=0;j<10;j++)
-            {
-                if(griduv[i][j]=='H')
-                    win++;
-            }
-        }
-        if(win==14)
+        if(userships==0)
         {
             printf("\nYou lose!\n");
             break;
         }
-        win=0;
     }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,244 @@
+/*
+C++ Battleship Game - Benchmarks
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <chrono>
+#include <atomic>
+#include <functional>
+#include <new>
+#include <cstdlib>
+#include <stdio.h>
+#include "Board.hpp"
+#include "Position.hpp"
+#include "Simulation.hpp"
+#include "Strategy.hpp"
+#include "Ruleset.hpp"
+#include "GameRules.hpp"
+#include "ProbabilityDensity.hpp"
+
+using namespace std;
+
+/*******************************************************************
+                ALLOCATION COUNTING
+********************************************************************/
+
+// Every allocation of the process goes through these, so a benchmark can report allocations per operation.
+static atomic<long> allocationCount(0);
+
+// The allocation functions are kept out of line. Otherwise GCC sees the `malloc` and `free` inside them at some
+// call sites and not at others, and warns that they do not match.
+#ifdef __GNUC__
+#define ALLOCATION_FUNCTION __attribute__((noinline))
+#else
+#define ALLOCATION_FUNCTION
+#endif
+
+ALLOCATION_FUNCTION void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+ALLOCATION_FUNCTION void* operator new[](size_t size) {return operator new(size);}
+ALLOCATION_FUNCTION void operator delete(void* memory) noexcept {free(memory);}
+ALLOCATION_FUNCTION void operator delete[](void* memory) noexcept {operator delete(memory);}
+void operator delete(void* memory, size_t) noexcept {operator delete(memory);}
+void operator delete[](void* memory, size_t) noexcept {operator delete[](memory);}
+
+/*******************************************************************
+                BENCHMARK RUNNER
+********************************************************************/
+
+// Discards everything written to it, so printing can be measured without a terminal.
+class NullBuffer: public streambuf {
+    protected:
+        int overflow(int c) {return c;}
+        streamsize xsputn(const char*, streamsize count) {return count;}
+};
+
+// Minimum time spent measuring every benchmark.
+double minSeconds = 0.2;
+
+// Runs `setup` (not measured) followed by `body` (measured) until enough time has been measured.
+// `body` returns the amount of operations it did.
+// Prints one JSON object per line, so results can be diffed and parsed between commits.
+void runBenchmark(string name, int boardSize, function<void()> setup, function<long()> body) {
+    typedef chrono::steady_clock clock;
+    long operations = 0, allocations = 0;
+    double seconds = 0;
+    // A first run that is not measured, so whatever is set up on first use (e.g. the fleet generator of a
+    // strategy, or touching new memory) does not end up in the first measurement.
+    setup();
+    body();
+    while (seconds < minSeconds) {
+        setup();
+        long allocationsBefore = allocationCount.load(memory_order_relaxed);
+        clock::time_point start = clock::now();
+        operations += body();
+        seconds += chrono::duration<double>(clock::now() - start).count();
+        allocations += allocationCount.load(memory_order_relaxed) - allocationsBefore;
+    }
+    printf("{\"benchmark\": \"%s\", \"board_size\": %d, \"operations\": %ld, \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"ops_per_sec\": %.0f}\n",
+        name.c_str(), boardSize, operations, seconds * 1e9 / operations, (double) allocations / operations, operations / seconds);
+    fflush(stdout);
+}
+
+// Places a ship of size 2 at the start of every other row, so every board size has ships to hit.
+void placeBenchmarkShips(Board& board) {
+    int boardSize = board.GetSize();
+    for (int y=0; y<boardSize; y+=2) {
+        board.PlaceShip({y*boardSize, y*boardSize + 1}, 2);
+    }
+}
+
+/*******************************************************************
+                MAIN
+********************************************************************/
+
+int main(int argc, char* argv[]) {
+    vector<int> boardSizes {8, 10, 16, 32, 64};
+    vector<int> shipSizes {5,4,3,3,2};
+    string filter;
+
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        if (arg == "--filter" && i+1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i+1 < argc) {
+            minSeconds = atof(argv[++i]);
+        } else {
+            cerr << "Usage: benchmark [--filter substring] [--min-time seconds]\n";
+            return 1;
+        }
+    }
+
+    NullBuffer nullBuffer;
+    streambuf* coutBuffer = cout.rdbuf();
+
+    for (int boardSize: boardSizes) {
+        int cells = boardSize*boardSize;
+        Board board("Benchmark", boardSize);
+        map<int, string> boardPrintStrings {
+            {1, getTopLineString(boardSize)},
+            {2, getXAxisString(boardSize)},
+            {3, getBottomLineString(boardSize)},
+            {4, getIntermediateLineString(boardSize)}
+        };
+        function<void()> resetWithShips = [&]() {
+            board.Reset();
+            placeBenchmarkShips(board);
+        };
+        map<string, pair<function<void()>, function<long()>>> benchmarks;
+
+        benchmarks["Position::GetAttacked"] = {resetWithShips, [&]() {
+            for (int i=0; i<cells; i++) {
+                board.GetPosition(i).GetAttacked();
+            }
+            return (long) cells;
+        }};
+        benchmarks["Board::GetAttacked"] = {resetWithShips, [&]() {
+            for (int i=0; i<cells; i++) {
+                board.GetAttacked(i);
+            }
+            return (long) cells;
+        }};
+        vector<int> salvoPositions;
+        vector<AttackResult> salvoResults(5);
+        benchmarks["Board::GetAttackedSalvo"] = {resetWithShips, [&]() {
+            for (int i=0; i<cells; i+=5) {
+                salvoPositions.clear();
+                for (int k=i; k<i+5 && k<cells; k++) {
+                    salvoPositions.push_back(k);
+                }
+                board.GetAttackedSalvo(salvoPositions.data(), salvoPositions.size(), salvoResults.data());
+            }
+            return (long) cells;
+        }};
+        vector<int> shipPositions;
+        benchmarks["Board::PlaceShip"] = {[&]() {board.Reset();}, [&]() {
+            long ships = 0;
+            for (int y=0; y<boardSize && ships<255; y++, ships++) {
+                shipPositions.clear();
+                for (int x=0; x<5; x++) {
+                    shipPositions.push_back(x + y*boardSize);
+                }
+                board.PlaceShip(shipPositions, 5);
+            }
+            return ships;
+        }};
+        benchmarks["getShipPositions"] = {[&]() {board.Reset();}, [&]() {
+            long placements = 0;
+            for (int i=0; i<cells; i++) {
+                if (getShipPositions(i, 3, 3, boardSize, board, shipPositions) == placed) {
+                    placements++;
+                }
+            }
+            return placements;
+        }};
+        benchmarks["Board::PrintBoard"] = {resetWithShips, [&]() {
+            cout.rdbuf(&nullBuffer);
+            board.PrintBoard(boardSize, true, boardPrintStrings);
+            cout.rdbuf(coutBuffer);
+            return 1L;
+        }};
+        Board restoredBoard("", boardSize);
+        stringstream snapshot;
+        benchmarks["Board::SaveSnapshot+LoadSnapshot"] = {resetWithShips, [&]() {
+            snapshot.seekp(0);
+            board.SaveSnapshot(snapshot);
+            snapshot.seekg(0);
+            restoredBoard.LoadSnapshot(snapshot);
+            return 1L;
+        }};
+        ProbabilityDensity density(boardSize);
+        benchmarks["ProbabilityDensity::Compute"] = {[&]() {
+            density.Clear();
+            for (int i=0; i<cells; i+=7) {
+                density.MarkMiss(i);
+            }
+            density.MarkHit(cells/2);
+        }, [&]() {
+            density.Compute(shipSizes);
+            return 1L;
+        }};
+        for (Ruleset ruleset: {classic, salvo}) {
+            for (string strategy: {"random", "hunttarget"}) {
+                string name = string("Simulation::Play/") + (ruleset == salvo ? "salvo/" : "classic/") + strategy;
+                shared_ptr<Simulation> simulation(new Simulation(ruleset, boardSize, shipSizes));
+                shared_ptr<Strategy> playerOne(createStrategy(strategy, 1)), playerTwo(createStrategy(strategy, 2));
+                benchmarks[name] = {[]() {}, [=]() {
+                    for (int game=0; game<16; game++) {
+                        simulation->Play(*playerOne, *playerTwo);
+                    }
+                    return 16L;
+                }};
+                // The same games through the virtual functions of the strategies, for comparison.
+                benchmarks[name + "/virtual"] = {[]() {}, [=]() {
+                    for (int game=0; game<16; game++) {
+                        if (ruleset == salvo) {
+                            simulation->Play<SalvoRules, Strategy, Strategy>(*playerOne, *playerTwo);
+                        } else {
+                            simulation->Play<ClassicRules, Strategy, Strategy>(*playerOne, *playerTwo);
+                        }
+                    }
+                    return 16L;
+                }};
+            }
+        }
+
+        for (auto& benchmark: benchmarks) {
+            if (benchmark.first.find(filter) != string::npos) {
+                runBenchmark(benchmark.first, boardSize, benchmark.second.first, benchmark.second.second);
+            }
+        }
+    }
+    return 0;
+};
@@ -0,0 +1,203 @@
+/*
+C++ Battleship Game - Bot Match
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <poll.h>
+#include "Game.hpp"
+#include "Board.hpp"
+#include "BotProcess.hpp"
+#include "Ruleset.hpp"
+
+using namespace std;
+
+// One game between the two bots. Bot `first` plays on board one and attacks first.
+struct Match {
+    int id;
+    int first;
+    bool placed;
+    unique_ptr<Game> game;
+    unique_ptr<Board> boards[2];
+    unique_ptr<BotPlayer> players[2];
+};
+
+// Results of all games, per bot.
+struct BotStats {
+    long wins;
+    // Sum of the shots the bot needed to win.
+    long shotsToWin;
+    // Games the bot lost by attacking illegal positions, see `maxIllegalAttacks`.
+    long forfeits;
+};
+
+void printUsage() {
+    cout << "Usage: botmatch [--games N] [--concurrent N] [--ruleset classic|salvo] [--size N] \"BOT A\" \"BOT B\"\n";
+    cout << "Plays two bot programs against each other (see `BotProtocol.hpp`), many games at once over one pipe per bot.\n";
+    cout << "Each bot is started with the shell, e.g. \"./strategybot density 1\".\n";
+}
+
+// Plays `match` as far as the bots have answered. Returns 'true' once it is over.
+bool advanceMatch(Match& match, const vector<int>& shipSizes) {
+    if (!match.placed) {
+        if (!match.game->PlaceShips(shipSizes)) {
+            return false;
+        }
+        match.placed = true;
+    }
+    while (match.game->Attack()) {
+        if (match.game->HasFinished()) {
+            return true;
+        }
+        match.game->EndTurn();
+    }
+    return false;
+}
+
+// Returns the value below which `fraction` of the sorted `values` lie.
+double getPercentile(const vector<double>& values, double fraction) {
+    return values.empty() ? 0.0 : values[min(values.size() - 1, (size_t) (fraction * values.size()))];
+}
+
+int main(int argc, char* argv[]) {
+
+    /// Match parameters
+    long gameCount = 1000;
+    int concurrent = 64;
+    Ruleset ruleset = classic;
+    int boardSize = 10;
+    vector<int> shipSizes {5,4,3,3,2};
+    vector<string> commands;
+
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--games" && hasValue) {
+            gameCount = atol(argv[++i]);
+        } else if (arg == "--concurrent" && hasValue) {
+            concurrent = atoi(argv[++i]);
+        } else if (arg == "--ruleset" && hasValue) {
+            ruleset = string(argv[++i]) == "salvo" ? salvo : classic;
+        } else if (arg == "--size" && hasValue) {
+            boardSize = atoi(argv[++i]);
+        } else if (arg[0] != '-') {
+            commands.push_back(arg);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (commands.size() != 2 || gameCount < 1 || concurrent < 1 || concurrent > 1000 || boardSize < shipSizes[0] || boardSize > 100) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        unique_ptr<BotProcess> bots[2] = {unique_ptr<BotProcess>(new BotProcess(commands[0])), unique_ptr<BotProcess>(new BotProcess(commands[1]))};
+        BotStats stats[2] = {};
+        vector<unique_ptr<Match>> matches;
+        long started = 0, finished = 0, moves = 0;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        while (finished < gameCount) {
+            // Start new games while there is room, alternating which bot attacks first.
+            while ((int) matches.size() < concurrent && started < gameCount) {
+                unique_ptr<Match> match(new Match());
+                match->id = started;
+                match->first = started % 2;
+                match->placed = false;
+                match->game.reset(ruleset == salvo ? (Game*) new SalvoGame(boardSize) : (Game*) new ClassicGame(boardSize));
+                for (int side=0; side<2; side++) {
+                    int bot = side == 0 ? match->first : !match->first;
+                    match->boards[side].reset(new Board(commands[bot], boardSize));
+                    match->players[side].reset(new BotPlayer(*bots[bot], match->id, ruleset));
+                }
+                match->game->SetBoardPlayerOne(match->boards[0].get());
+                match->game->SetBoardPlayerTwo(match->boards[1].get());
+                match->game->SetPlayers(match->players[0].get(), match->players[1].get());
+                matches.push_back(move(match));
+                started++;
+            }
+
+            // Play every game as far as the answers so far allow, which collects the next requests for the bots.
+            for (size_t m=0; m<matches.size(); ) {
+                Match& match = *matches[m];
+                if (!advanceMatch(match, shipSizes)) {
+                    m++;
+                    continue;
+                }
+                // The player whose turn it is won, unless they forfeited.
+                int winnerSide = match.game->IsPlayerTwoTurn() != match.game->HasForfeited();
+                int winner = winnerSide == 0 ? match.first : !match.first;
+                stats[winner].wins++;
+                if (match.game->HasForfeited()) {
+                    stats[!winner].forfeits++;
+                }
+                stats[winner].shotsToWin += match.boards[!winnerSide]->GetAttackedPlane().Count();
+                moves += match.boards[0]->GetAttackedPlane().Count() + match.boards[1]->GetAttackedPlane().Count();
+                bots[winner]->SendEnd(match.id, true);
+                bots[!winner]->SendEnd(match.id, false);
+                finished++;
+                matches[m] = move(matches.back());
+                matches.pop_back();
+            }
+
+            // All requests of a round go out in one write per bot, then wait for whichever bot answers first.
+            bots[0]->Flush();
+            bots[1]->Flush();
+            bool handled = false;
+            for (int bot=0; bot<2; bot++) {
+                handled = bots[bot]->HandleBufferedAnswers() || handled;
+            }
+            if (handled || matches.empty()) {
+                continue;
+            }
+            pollfd fds[2];
+            for (int bot=0; bot<2; bot++) {
+                fds[bot].fd = bots[bot]->IsWaiting() ? bots[bot]->GetAnswerFd() : -1;
+                fds[bot].events = POLLIN;
+                fds[bot].revents = 0;
+            }
+            poll(fds, 2, -1);
+            for (int bot=0; bot<2; bot++) {
+                if (fds[bot].revents) {
+                    bots[bot]->ReadAnswers();
+                }
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        printf("%-32s %8s %10s %10s %10s %10s %10s\n", "bot", "win%", "shots", "mean us", "p50 us", "p99 us", "max us");
+        for (int bot=0; bot<2; bot++) {
+            vector<double> latencies = bots[bot]->GetMoveLatencies();
+            sort(latencies.begin(), latencies.end());
+            double sum = 0.0;
+            for (double latency: latencies) {
+                sum += latency;
+            }
+            printf("%-32s %8.2f %10.2f %10.1f %10.1f %10.1f %10.1f\n", commands[bot].c_str(), 100.0 * stats[bot].wins / finished,
+                stats[bot].wins ? (double) stats[bot].shotsToWin / stats[bot].wins : 0.0,
+                latencies.empty() ? 0.0 : 1e6 * sum / latencies.size(), 1e6 * getPercentile(latencies, 0.5),
+                1e6 * getPercentile(latencies, 0.99), latencies.empty() ? 0.0 : 1e6 * latencies.back());
+        }
+        for (int bot=0; bot<2; bot++) {
+            if (stats[bot].forfeits) {
+                printf("%s forfeited %ld games by attacking illegal positions\n", commands[bot].c_str(), stats[bot].forfeits);
+            }
+        }
+        printf("\n%ld %s games, %d at once, in %.2f s (%.0f games/s, %.0f moves/s)\n", finished, ruleset == salvo ? "salvo" : "classic",
+            concurrent, seconds, finished / seconds, moves / seconds);
+    } catch (const char* error) {
+        cerr << "botmatch: " << error << "\n";
+        return 1;
+    }
+
+    return 0;
+};
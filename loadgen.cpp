@@ -0,0 +1,312 @@
+/*
+C++ Battleship Game - Load Generator
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "Socket.hpp"
+#include "ServerProtocol.hpp"
+#include "ByteOrder.hpp"
+#include "Ruleset.hpp"
+#include "AttackResult.hpp"
+#include "Random.hpp"
+
+using namespace std;
+
+// One simulated player, connected to the server.
+struct Client {
+    int socket;
+    int player;
+    // The other player of the pair: the creator of the games for the joining player and the other way around.
+    Client* partner;
+    vector<uint8_t> input, output;
+    bool waitingToWrite;
+    // Positions of the opponent board not attacked yet, in the order they will be attacked.
+    vector<int> targets;
+    size_t nextTarget;
+    chrono::steady_clock::time_point firedAt;
+};
+
+// Totals of one thread of the load generator.
+struct LoadStats {
+    long moves;
+    long games;
+    long failures;
+    long roundTrips;
+    double roundTripSeconds;
+};
+
+// Plays `pairs` games at once from one thread, starting a new game whenever one ends, until `end`.
+class LoadThread {
+    private:
+        int epoll;
+        Ruleset ruleset;
+        int boardSize;
+        vector<unique_ptr<Client>> clients;
+        Random random;
+
+        void Send(Client& client, const uint8_t* message, int length) {
+            client.output.insert(client.output.end(), message, message + length);
+            Write(client);
+        }
+
+        void Write(Client& client) {
+            while (!client.output.empty()) {
+                ssize_t sent = send(client.socket, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+                if (sent < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (sent < 0 && errno != EAGAIN) {
+                    throw "The server closed a connection.";
+                }
+                if (sent < 0) {
+                    break;
+                }
+                client.output.erase(client.output.begin(), client.output.begin() + sent);
+            }
+            bool waitToWrite = !client.output.empty();
+            if (waitToWrite != client.waitingToWrite) {
+                epoll_event event;
+                event.events = EPOLLIN | (waitToWrite ? (uint32_t) EPOLLOUT : 0);
+                event.data.ptr = &client;
+                epoll_ctl(epoll, EPOLL_CTL_MOD, client.socket, &event);
+                client.waitingToWrite = waitToWrite;
+            }
+        }
+
+        void CreateGame(Client& creator) {
+            uint8_t request[3] = {createGame, (uint8_t) ruleset, (uint8_t) boardSize};
+            Send(creator, request, sizeof(request));
+        }
+
+        void Handle(Client& client, const uint8_t* message, LoadStats& stats) {
+            switch (message[0]) {
+            case gameCreated: {
+                uint8_t request[5] = {joinGame};
+                memcpy(request + 1, message + 1, 4);
+                Send(*client.partner, request, sizeof(request));
+                break;
+            }
+            case gameJoined: {
+                // A new game: shuffle the positions to attack, and let the server place the fleet.
+                client.player = message[3];
+                for (size_t i=client.targets.size()-1; i>0; i--) {
+                    swap(client.targets[i], client.targets[random.Next() % (i+1)]);
+                }
+                client.nextTarget = 0;
+                uint8_t request[2] = {placeFleet, 0};
+                Send(client, request, sizeof(request));
+                break;
+            }
+            case yourTurn: {
+                int count = message[1];
+                uint8_t request[2 + 2*255] = {fire, (uint8_t) count};
+                for (int i=0; i<count; i++) {
+                    writeUint16(request + 2 + 2*i, client.targets[client.nextTarget++]);
+                }
+                client.firedAt = chrono::steady_clock::now();
+                Send(client, request, 2 + 2*count);
+                break;
+            }
+            case fired: {
+                int count = message[2];
+                if (message[1] == client.player) {
+                    stats.moves += count;
+                    stats.roundTrips++;
+                    stats.roundTripSeconds += chrono::duration<double>(chrono::steady_clock::now() - client.firedAt).count();
+                }
+                // The creator starts the next game once it has seen the last shot of this one.
+                if (message[3 + 3*(count-1) + 2] == won && client.player == 0) {
+                    stats.games++;
+                    CreateGame(client);
+                }
+                break;
+            }
+            case requestFailed:
+                stats.failures++;
+                break;
+            }
+        }
+
+    public:
+        LoadThread(const ServerAddress& address, int pairs, Ruleset ruleset, int boardSize, uint64_t seed) : random(seed) {
+            this->ruleset = ruleset;
+            this->boardSize = boardSize;
+            this->epoll = epoll_create1(EPOLL_CLOEXEC);
+            vector<int> targets(boardSize*boardSize);
+            for (int i=0; i<boardSize*boardSize; i++) {
+                targets[i] = i;
+            }
+            for (int i=0; i<2*pairs; i++) {
+                Client* client = new Client();
+                clients.push_back(unique_ptr<Client>(client));
+                client->socket = connectTo(address);
+                client->waitingToWrite = false;
+                client->targets = targets;
+                client->nextTarget = 0;
+                epoll_event event;
+                event.events = EPOLLIN;
+                event.data.ptr = client;
+                epoll_ctl(epoll, EPOLL_CTL_ADD, client->socket, &event);
+                if (i % 2 == 1) {
+                    client->partner = clients[i-1].get();
+                    clients[i-1]->partner = client;
+                }
+            }
+        }
+
+        ~LoadThread() {
+            for (unique_ptr<Client>& client: clients) {
+                close(client->socket);
+            }
+            close(epoll);
+        }
+
+        LoadStats Run(chrono::steady_clock::time_point end) {
+            LoadStats stats = LoadStats();
+            for (size_t i=0; i<clients.size(); i+=2) {
+                CreateGame(*clients[i]);
+            }
+            epoll_event events[256];
+            while (chrono::steady_clock::now() < end) {
+                int count = epoll_wait(epoll, events, 256, 100);
+                for (int i=0; i<count; i++) {
+                    Client& client = *(Client*) events[i].data.ptr;
+                    if (events[i].events & EPOLLOUT) {
+                        Write(client);
+                    }
+                    if (!(events[i].events & EPOLLIN)) {
+                        continue;
+                    }
+                    uint8_t buffer[16384];
+                    ssize_t received = recv(client.socket, buffer, sizeof(buffer), 0);
+                    if (received == 0 || (received < 0 && errno != EAGAIN && errno != EINTR)) {
+                        throw "The server closed a connection.";
+                    }
+                    if (received < 0) {
+                        continue;
+                    }
+                    client.input.insert(client.input.end(), buffer, buffer + received);
+                    size_t handled = 0;
+                    int length;
+                    while ((length = getResponseLength(client.input.data() + handled, client.input.size() - handled)) > 0) {
+                        Handle(client, client.input.data() + handled, stats);
+                        handled += length;
+                    }
+                    if (length < 0) {
+                        throw "The server sent a malformed message.";
+                    }
+                    client.input.erase(client.input.begin(), client.input.begin() + handled);
+                }
+            }
+            return stats;
+        }
+};
+
+void printUsage() {
+    cout << "Usage: loadgen [--tcp PORT | --unix PATH] [--games N] [--threads N] [--seconds N] [--ruleset classic|salvo] [--size N]\n";
+    cout << "Plays N games at once against a running server, with random shots, and reports the moves per second.\n";
+}
+
+int main(int argc, char* argv[]) {
+
+    /// Load parameters
+    ServerAddress address {false, 7650, ""};
+    int games = 1000;
+    int threadCount = 1;
+    double seconds = 10;
+    Ruleset ruleset = classic;
+    int boardSize = 10;
+
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--tcp" && hasValue) {
+            address.unixSocket = false;
+            address.port = atoi(argv[++i]);
+        } else if (arg == "--unix" && hasValue) {
+            address.unixSocket = true;
+            address.path = argv[++i];
+        } else if (arg == "--games" && hasValue) {
+            games = atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = atoi(argv[++i]);
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = atof(argv[++i]);
+        } else if (arg == "--ruleset" && hasValue) {
+            ruleset = string(argv[++i]) == "salvo" ? salvo : classic;
+        } else if (arg == "--size" && hasValue) {
+            boardSize = atoi(argv[++i]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (games < 1 || threadCount < 1 || boardSize < 5 || boardSize > 100) {
+        printUsage();
+        return 1;
+    }
+
+    raiseOpenFileLimit();
+    vector<unique_ptr<LoadThread>> loadThreads;
+    try {
+        for (int t=0; t<threadCount; t++) {
+            int pairs = games / threadCount + (t < games % threadCount);
+            loadThreads.push_back(unique_ptr<LoadThread>(new LoadThread(address, pairs, ruleset, boardSize, t + 1)));
+        }
+    } catch (const char* error) {
+        cerr << error << "\n";
+        return 1;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    chrono::steady_clock::time_point end = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+    vector<LoadStats> threadStats(threadCount);
+    vector<thread> threads;
+    atomic<bool> failed(false);
+    for (int t=0; t<threadCount; t++) {
+        threads.push_back(thread([&, t]() {
+            try {
+                threadStats[t] = loadThreads[t]->Run(end);
+            } catch (const char* error) {
+                cerr << error << "\n";
+                failed = true;
+            }
+        }));
+    }
+    for (thread& loadThread: threads) {
+        loadThread.join();
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (failed) {
+        return 1;
+    }
+
+    LoadStats total = LoadStats();
+    for (LoadStats& stats: threadStats) {
+        total.moves += stats.moves;
+        total.games += stats.games;
+        total.failures += stats.failures;
+        total.roundTrips += stats.roundTrips;
+        total.roundTripSeconds += stats.roundTripSeconds;
+    }
+    printf("%d concurrent %s games on %d threads for %.1f s\n", games, ruleset == salvo ? "salvo" : "classic", threadCount, elapsed);
+    printf("%.0f moves/s, %.0f games/s, %.1f us per turn round trip, %ld failed requests\n", total.moves / elapsed, total.games / elapsed,
+        total.roundTrips ? 1e6 * total.roundTripSeconds / total.roundTrips : 0.0, total.failures);
+
+    return 0;
+};
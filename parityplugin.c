@@ -0,0 +1,100 @@
+/*
+C++ Battleship Game - Parity Plugin
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <stdlib.h>
+#include <stdint.h>
+#include "BattleshipPlugin.h"
+
+/*
+An example strategy plugin in plain C (see `BattleshipPlugin.h`). It fires at the unattacked neighbours of hits
+first, and otherwise at a random position on a checkerboard spaced by the smallest ship left, since every ship
+covers at least one of those. It works on the bit-planes it is given and keeps no board of its own.
+*/
+
+typedef struct ParityBot {
+    uint64_t state;
+} ParityBot;
+
+static uint32_t nextRandom(ParityBot* bot) {
+    /* xorshift64* */
+    bot->state ^= bot->state >> 12;
+    bot->state ^= bot->state << 25;
+    bot->state ^= bot->state >> 27;
+    return (uint32_t) ((bot->state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static int testBit(const uint64_t* plane, int index) {
+    return (plane[index >> 6] >> (index & 63)) & 1;
+}
+
+static void* create(uint64_t seed) {
+    ParityBot* bot = (ParityBot*) malloc(sizeof(ParityBot));
+    if (bot) {
+        bot->state = seed * 0x9e3779b97f4a7c15ULL + 1;
+    }
+    return bot;
+}
+
+static void destroy(void* bot) {
+    free(bot);
+}
+
+static int32_t chooseAttack(void* state, const BattleshipBoardView* view) {
+    ParityBot* bot = (ParityBot*) state;
+    int size = view->board_size;
+    int positions = size * size;
+    int spacing = 2;
+    int i, index, count = 0, chosen = -1, first = -1;
+
+    /* Neighbours of hits. Sunk ships are not told apart from the others, so some of these are wasted. */
+    for (index = 0; index < positions; index++) {
+        int x = index % size, y = index / size;
+        if (!testBit(view->hit, index)) {
+            continue;
+        }
+        if (x > 0 && !testBit(view->attacked, index - 1)) return index - 1;
+        if (x < size - 1 && !testBit(view->attacked, index + 1)) return index + 1;
+        if (y > 0 && !testBit(view->attacked, index - size)) return index - size;
+        if (y < size - 1 && !testBit(view->attacked, index + size)) return index + size;
+    }
+
+    if (view->remaining_ship_sizes && view->ships_left > 0) {
+        spacing = view->remaining_ship_sizes[0];
+        for (i = 1; i < view->ships_left; i++) {
+            if (view->remaining_ship_sizes[i] < spacing) {
+                spacing = view->remaining_ship_sizes[i];
+            }
+        }
+    }
+
+    /* A random unattacked position on the checkerboard, chosen in one pass, or else the first unattacked one. */
+    for (index = 0; index < positions; index++) {
+        if (testBit(view->attacked, index)) {
+            continue;
+        }
+        if (first < 0) {
+            first = index;
+        }
+        if ((index % size + index / size) % spacing == 0 && nextRandom(bot) % ++count == 0) {
+            chosen = index;
+        }
+    }
+    return chosen >= 0 ? chosen : first;
+}
+
+static const BattleshipPlugin plugin = {
+    BATTLESHIP_PLUGIN_API_VERSION,
+    "parity",
+    create,
+    destroy,
+    NULL,
+    NULL,
+    chooseAttack,
+    NULL
+};
+
+BATTLESHIP_PLUGIN_EXPORT const BattleshipPlugin* battleship_plugin(void) {
+    return &plugin;
+}
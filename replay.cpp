@@ -0,0 +1,111 @@
+/*
+C++ Battleship Game - Replay
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include "GameRecord.hpp"
+#include "Ruleset.hpp"
+
+using namespace std;
+
+void printUsage() {
+    cout << "Usage: replay FILE [--game N [--from SHOT]]\n";
+    cout << "Summarizes the games in a record file, or prints every ship and shot of game N (counting from 0).\n";
+    cout << "With --from, the boards are restored to where they were before SHOT and only the shots from there on are printed.\n";
+}
+
+// Prints the fleets and the shots of one game from shot `firstShot` on.
+void printGame(const RecordedGame& game, int firstShot) {
+    const char* resultNames[] = {"miss", "hit", "sunk", "won"};
+    int boardSize = game.GetBoardSize();
+    printf("%s game on a %dx%d board, ", game.GetRuleset() == salvo ? "salvo" : "classic", boardSize, boardSize);
+    if (game.GetWinner() < 0) {
+        printf("not finished\n");
+    } else {
+        printf("won by player %d\n", game.GetWinner() + 1);
+    }
+    for (int player=0; player<2; player++) {
+        printf("Player %d ships:", player + 1);
+        for (int ship=0; ship<game.GetShipCount(); ship++) {
+            RecordedShip recordedShip = game.GetShip(player, ship);
+            printf(" %d at (%d,%d) %s;", recordedShip.size, recordedShip.origin % boardSize, recordedShip.origin / boardSize,
+                recordedShip.vertical ? "down" : "right");
+        }
+        printf("\n");
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    RecordedGameCursor cursor(game, firstShot);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (firstShot > 0) {
+        printf("Restored the boards before shot %d of %d in %.1f us\n", cursor.GetShotNumber(), game.GetShotCount(), seconds * 1e6);
+        for (int player=0; player<2; player++) {
+            printf("Player %d board: %d positions attacked\n", player + 1, cursor.GetAttacked(player).Count());
+        }
+    }
+    RecordedShot recordedShot;
+    for (int shot=cursor.GetShotNumber(); cursor.Next(recordedShot); shot++) {
+        printf("%5d  player %d  (%d,%d)  %s\n", shot, recordedShot.player + 1,
+            recordedShot.position % boardSize, recordedShot.position / boardSize, resultNames[recordedShot.result]);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string path;
+    long gameToPrint = -1;
+    int firstShot = 0;
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        if (arg == "--game" && i+1 < argc) {
+            gameToPrint = atol(argv[++i]);
+        } else if (arg == "--from" && i+1 < argc) {
+            firstShot = atoi(argv[++i]);
+        } else if (arg[0] != '-' && path.empty()) {
+            path = arg;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (path.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        GameRecordFile file(path);
+        size_t offset = file.GetFirstGameOffset();
+        RecordedGame game;
+        long games = 0, shots = 0, wins[2] = {0, 0};
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        while (file.ReadGame(offset, game)) {
+            if (games == gameToPrint) {
+                printGame(game, firstShot);
+                return 0;
+            }
+            games++;
+            shots += game.GetShotCount();
+            if (game.GetWinner() >= 0) {
+                wins[game.GetWinner()]++;
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (gameToPrint >= 0) {
+            cerr << "The file only has " << games << " games.\n";
+            return 1;
+        }
+        printf("%ld games, %ld shots, %.1f bytes per game\n", games, shots, games ? (double) file.GetSize() / games : 0.0);
+        printf("player 1 won %ld, player 2 won %ld, %ld not finished\n", wins[0], wins[1], games - wins[0] - wins[1]);
+        printf("read in %.3f s (%.0f games/s)\n", seconds, games / seconds);
+    } catch (const char* e) {
+        cerr << e << "\n";
+        return 1;
+    }
+    return 0;
+};
@@ -0,0 +1,91 @@
+/*
+C++ Battleship Game - Server
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "GameServer.hpp"
+#include "Socket.hpp"
+
+using namespace std;
+
+atomic<bool> stopRequested(false);
+
+void requestStop(int) {
+    stopRequested = true;
+}
+
+void printUsage() {
+    cout << "Usage: server [--tcp PORT | --unix PATH] [--threads N]\n";
+    cout << "Hosts games between remote players until interrupted, on TCP port 7650 of the loopback address by default.\n";
+}
+
+int main(int argc, char* argv[]) {
+
+    /// Server parameters
+    ServerAddress address {false, 7650, ""};
+    int threadCount = thread::hardware_concurrency();
+    vector<int> shipSizes {5,4,3,3,2};
+
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--tcp" && hasValue) {
+            address.unixSocket = false;
+            address.port = atoi(argv[++i]);
+        } else if (arg == "--unix" && hasValue) {
+            address.unixSocket = true;
+            address.path = argv[++i];
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = atoi(argv[++i]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    long openFileLimit = raiseOpenFileLimit();
+    try {
+        GameServer server(listenAt(address), threadCount, shipSizes);
+        signal(SIGINT, requestStop);
+        signal(SIGTERM, requestStop);
+        server.Start();
+        printf("Listening on %s with %d threads, up to %ld connections\n",
+            address.unixSocket ? address.path.c_str() : ("port " + to_string(address.port)).c_str(), server.GetLoopCount(), openFileLimit);
+        fflush(stdout);
+
+        // Report the throughput every second.
+        long lastMoves = 0, lastGames = 0;
+        chrono::steady_clock::time_point last = chrono::steady_clock::now();
+        while (!stopRequested) {
+            this_thread::sleep_for(chrono::milliseconds(100));
+            chrono::steady_clock::time_point now = chrono::steady_clock::now();
+            double seconds = chrono::duration<double>(now - last).count();
+            if (seconds >= 1) {
+                long moves = server.GetMoveCount(), games = server.GetFinishedGameCount();
+                if (moves != lastMoves) {
+                    printf("%.0f moves/s, %.0f games/s\n", (moves - lastMoves) / seconds, (games - lastGames) / seconds);
+                    fflush(stdout);
+                }
+                lastMoves = moves;
+                lastGames = games;
+                last = now;
+            }
+        }
+        server.Stop();
+        printf("%ld moves in %ld finished games\n", server.GetMoveCount(), server.GetFinishedGameCount());
+    } catch (const char* error) {
+        cerr << error << "\n";
+        return 1;
+    }
+
+    return 0;
+};
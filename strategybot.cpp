@@ -0,0 +1,142 @@
+/*
+C++ Battleship Game - Strategy Bot
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <stdlib.h>
+#include "BotProtocol.hpp"
+#include "Board.hpp"
+#include "Bitboard.hpp"
+#include "EnemyBoardView.hpp"
+#include "Player.hpp"
+#include "Strategy.hpp"
+#include "Random.hpp"
+
+using namespace std;
+
+// An example bot for `botmatch` (see the bot side of `BotProtocol.hpp`), which lets one of the strategies of the
+// headless games play every game it is sent. It only knows the results of its own attacks, like any bot.
+
+static const char orientationLetters[4] = {'U', 'D', 'L', 'R'};
+
+// Everything the bot knows about one game.
+struct BotGame {
+    unique_ptr<Strategy> strategy;
+    unique_ptr<Board> ownBoard;
+    // The attacked and hit planes of the enemy's board, as far as the results of the attacks tell.
+    vector<uint64_t> planeWords;
+    Bitboard attackedPlane, hitPlane;
+    int boardSize, shipsLeft;
+    // The positions of the last FIRE, waiting for their results.
+    vector<int> salvo;
+};
+
+void printUsage() {
+    cerr << "Usage: strategybot STRATEGY [SEED]\nPlays the games given on standard input with STRATEGY. Strategies:";
+    for (string name: getStrategyNames()) {
+        cerr << " " << name;
+    }
+    cerr << "\n";
+}
+
+// Writes one PLACE line per ship on `board`, in the order the ships were placed.
+// A ship starts at its lowest position and goes right if the next position in the row is part of it, down otherwise.
+void writePlacement(BotWriter& writer, int game, Board& board) {
+    int boardSize = board.GetSize();
+    vector<pair<Ship*, int>> origins;
+    for (int i=0; i<boardSize*boardSize; i++) {
+        Ship* ship = board.GetShip(i);
+        if (ship && find_if(origins.begin(), origins.end(), [ship](const pair<Ship*, int>& origin) {return origin.first == ship;}) == origins.end()) {
+            origins.push_back(make_pair(ship, i));
+        }
+    }
+    // The ships of a board are stored in the order they were placed.
+    sort(origins.begin(), origins.end());
+    for (const pair<Ship*, int>& origin: origins) {
+        int i = origin.second;
+        bool right = (i+1) % boardSize != 0 && board.GetShip(i+1) == origin.first;
+        writer.Write(game);
+        writer.Write(" PLACE ");
+        writer.Write(i % boardSize);
+        writer.Write(' ');
+        writer.Write(i / boardSize);
+        writer.Write(' ');
+        writer.Write(orientationLetters[right ? 3 : 1]);
+        writer.Write('\n');
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3 || !createStrategy(argv[1], 0)) {
+        printUsage();
+        return 1;
+    }
+    string strategyName = argv[1];
+    uint64_t seed = argc == 3 ? strtoull(argv[2], NULL, 10) : 1;
+
+    BotWriter writer(1);
+    LineReader reader(0, &writer);
+    Random random(seed);
+    unordered_map<int, BotGame> games;
+    BotCommand command;
+    const char* begin, * end;
+    while (reader.ReadLine(begin, end)) {
+        int id;
+        if (!parseGameNumber(begin, end, id) || !parseBotCommand(begin, end, command)) {
+            cerr << "strategybot: could not read a command\n";
+            return 1;
+        }
+        if (command.type == gameCommand) {
+            BotGame& game = games[id];
+            game.boardSize = command.boardSize;
+            game.shipsLeft = command.shipSizes.size();
+            game.strategy = createStrategy(strategyName, random.Next());
+            game.strategy->NewGame(game.boardSize);
+            game.ownBoard.reset(new Board("Bot", game.boardSize));
+            int bits = game.boardSize*game.boardSize;
+            game.planeWords.assign(2*Bitboard::GetWordCount(bits), 0);
+            game.attackedPlane = Bitboard(game.planeWords.data(), bits);
+            game.hitPlane = Bitboard(game.planeWords.data() + Bitboard::GetWordCount(bits), bits);
+            game.strategy->PlaceShips(*game.ownBoard, command.shipSizes);
+            writePlacement(writer, id, *game.ownBoard);
+        } else if (command.type == turnCommand && games.count(id)) {
+            BotGame& game = games[id];
+            EnemyBoardView enemyBoard(game.boardSize, game.shipsLeft, game.attackedPlane, game.hitPlane);
+            chooseStrategySalvo(*game.strategy, enemyBoard, command.count, random, game.salvo);
+            writer.Write(id);
+            writer.Write(" FIRE");
+            for (int posIndex: game.salvo) {
+                writer.Write(' ');
+                writer.Write(posIndex % game.boardSize);
+                writer.Write(' ');
+                writer.Write(posIndex / game.boardSize);
+            }
+            writer.Write('\n');
+        } else if (command.type == resultCommand && games.count(id)) {
+            BotGame& game = games[id];
+            for (size_t i=0; i<command.results.size() && i<game.salvo.size(); i++) {
+                AttackResult result = command.results[i];
+                game.attackedPlane.Set(game.salvo[i]);
+                if (result != miss) {
+                    game.hitPlane.Set(game.salvo[i]);
+                }
+                if (result == sunk || result == won) {
+                    game.shipsLeft--;
+                }
+                game.strategy->ReceiveAttackResult(game.salvo[i], result);
+            }
+        } else if (command.type == endCommand) {
+            games.erase(id);
+        } else {
+            cerr << "strategybot: unexpected command for game " << id << "\n";
+            return 1;
+        }
+    }
+    return 0;
+};
@@ -0,0 +1,215 @@
+/*
+C++ Battleship Game - Tournament
+Version: 1.0
+Author: Enrique Dehaerne
+*/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Simulation.hpp"
+#include "Strategy.hpp"
+#include "PluginStrategy.hpp"
+#include "Ruleset.hpp"
+#include "WorkStealingScheduler.hpp"
+#include "GameRecord.hpp"
+#include "Metrics.hpp"
+
+using namespace std;
+
+// Games played by one task. Small enough to balance the load, large enough to make scheduling cheap.
+const int gamesPerTask = 1000;
+
+// Results of all games between two strategies, as seen from the first strategy ('A').
+struct PairingStats {
+    long games;
+    long wins[2];
+    // Sum of the shots the winner needed, per strategy.
+    long shotsToWin[2];
+    // Games lost by attacking illegal positions, per strategy.
+    long forfeits[2];
+};
+
+struct Pairing {
+    int strategies[2];
+};
+
+void printUsage() {
+    cout << "Usage: tournament [--games N] [--ruleset classic|salvo] [--size N] [--threads N] [--seed N] [--record FILE]\n"
+        << "                  [--metrics TARGET [--metrics-interval SECONDS]] [strategy...]\n";
+    cout << "Plays every pair of strategies against each other, optionally recording every game to FILE.\n";
+    cout << "TARGET is a file (JSON if it ends in .json, Prometheus text otherwise) or unix:PATH, see Metrics.hpp. Strategies:";
+    for (string name: getStrategyNames()) {
+        cout << " " << name;
+    }
+    cout << ", or the path of a plugin (see BattleshipPlugin.h), e.g. ./parityplugin.so\n";
+}
+
+int main(int argc, char* argv[]) {
+
+    /// Tournament parameters
+    long gamesPerPairing = 100000;
+    Ruleset ruleset = classic;
+    int boardSize = 10;
+    vector<int> shipSizes {5,4,3,3,2};
+    int threadCount = thread::hardware_concurrency();
+    uint64_t seed = 1;
+    vector<string> strategyNames;
+    string recordPath, metricsTarget;
+    double metricsInterval = 5.0;
+
+    for (int i=1; i<argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--games" && hasValue) {
+            gamesPerPairing = atol(argv[++i]);
+        } else if (arg == "--ruleset" && hasValue) {
+            ruleset = string(argv[++i]) == "salvo" ? salvo : classic;
+        } else if (arg == "--size" && hasValue) {
+            boardSize = atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--metrics" && hasValue) {
+            metricsTarget = argv[++i];
+        } else if (arg == "--metrics-interval" && hasValue) {
+            metricsInterval = atof(argv[++i]);
+        } else if (arg[0] != '-' && createStrategyOrPlugin(arg, 0)) {
+            strategyNames.push_back(arg);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (strategyNames.empty()) {
+        strategyNames = getStrategyNames();
+    }
+    if (strategyNames.size() < 2 || gamesPerPairing < 1 || boardSize < shipSizes[0] || metricsInterval <= 0) {
+        printUsage();
+        return 1;
+    }
+    if (!metricsTarget.empty() && !hasMetrics()) {
+        cerr << "This build has no metrics, build it with -DBATTLESHIP_METRICS to have them.\n";
+        return 1;
+    }
+
+    // Every strategy plays every other strategy.
+    vector<Pairing> pairings;
+    for (size_t a=0; a<strategyNames.size(); a++) {
+        for (size_t b=a+1; b<strategyNames.size(); b++) {
+            pairings.push_back({{(int) a, (int) b}});
+        }
+    }
+
+    // Every worker keeps its own boards and statistics, so workers never wait on each other while playing.
+    WorkStealingScheduler scheduler(threadCount);
+    int workerCount = scheduler.GetWorkerCount();
+    vector<unique_ptr<Simulation>> simulations;
+    for (int worker=0; worker<workerCount; worker++) {
+        simulations.push_back(unique_ptr<Simulation>(new Simulation(ruleset, boardSize, shipSizes)));
+    }
+    vector<vector<PairingStats>> workerStats(workerCount, vector<PairingStats>(pairings.size(), PairingStats()));
+
+    // Games are recorded per worker and written to the record file after every task.
+    ofstream recordFile;
+    mutex recordFileMutex;
+    vector<GameRecorder> recorders(workerCount);
+    if (!recordPath.empty()) {
+        recordFile.open(recordPath, ios::binary | ios::trunc);
+        if (!recordFile) {
+            cerr << "Could not open " << recordPath << "\n";
+            return 1;
+        }
+        writeGameRecordFileHeader(recordFile);
+        for (int worker=0; worker<workerCount; worker++) {
+            simulations[worker]->SetRecorder(&recorders[worker]);
+        }
+    }
+
+    long taskIndex = 0;
+    for (size_t p=0; p<pairings.size(); p++) {
+        for (long first=0; first<gamesPerPairing; first+=gamesPerTask, taskIndex++) {
+            long games = min((long) gamesPerTask, gamesPerPairing - first);
+            // Seeds depend on the task only, so results do not depend on which worker runs it.
+            uint64_t taskSeed = seed * 0x9e3779b97f4a7c15ULL + taskIndex * 2;
+            scheduler.AddTask([&, p, games, taskSeed](int worker) {
+                const Pairing& pairing = pairings[p];
+                unique_ptr<Strategy> players[2] = {
+                    createStrategyOrPlugin(strategyNames[pairing.strategies[0]], taskSeed),
+                    createStrategyOrPlugin(strategyNames[pairing.strategies[1]], taskSeed + 1)
+                };
+                PairingStats& stats = workerStats[worker][p];
+                for (long g=0; g<games; g++) {
+                    // Alternate which strategy attacks first.
+                    int first = g % 2;
+                    GameResult result = simulations[worker]->Play(*players[first], *players[!first]);
+                    int winner = result.winner == 0 ? first : !first;
+                    stats.games++;
+                    stats.wins[winner]++;
+                    stats.shotsToWin[winner] += result.shots[result.winner];
+                    if (result.forfeited) {
+                        stats.forfeits[!winner]++;
+                    }
+                }
+                if (recordFile.is_open()) {
+                    lock_guard<mutex> lock(recordFileMutex);
+                    recorders[worker].Flush(recordFile);
+                }
+            });
+        }
+    }
+
+    // The metrics are reported while the games are played, and once more when they are done.
+    unique_ptr<MetricsReporter> metricsReporter;
+    if (!metricsTarget.empty()) {
+        metricsReporter.reset(new MetricsReporter(metricsTarget, metricsInterval));
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    scheduler.Run();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    metricsReporter.reset();
+
+    long totalGames = 0;
+    vector<string> forfeitLines;
+    printf("%-32s %10s %8s %8s %10s %10s\n", "pairing (A vs B)", "games", "win% A", "win% B", "shots A", "shots B");
+    for (size_t p=0; p<pairings.size(); p++) {
+        PairingStats total = PairingStats();
+        for (int worker=0; worker<workerCount; worker++) {
+            PairingStats& stats = workerStats[worker][p];
+            total.games += stats.games;
+            for (int side=0; side<2; side++) {
+                total.wins[side] += stats.wins[side];
+                total.shotsToWin[side] += stats.shotsToWin[side];
+                total.forfeits[side] += stats.forfeits[side];
+            }
+        }
+        totalGames += total.games;
+        string name = strategyNames[pairings[p].strategies[0]] + " vs " + strategyNames[pairings[p].strategies[1]];
+        printf("%-32s %10ld %8.2f %8.2f %10.2f %10.2f\n", name.c_str(), total.games,
+            100.0 * total.wins[0] / total.games, 100.0 * total.wins[1] / total.games,
+            total.wins[0] ? (double) total.shotsToWin[0] / total.wins[0] : 0.0,
+            total.wins[1] ? (double) total.shotsToWin[1] / total.wins[1] : 0.0);
+        for (int side=0; side<2; side++) {
+            if (total.forfeits[side]) {
+                forfeitLines.push_back(strategyNames[pairings[p].strategies[side]] + " forfeited " + to_string(total.forfeits[side])
+                    + " games against " + strategyNames[pairings[p].strategies[!side]] + " by attacking illegal positions");
+            }
+        }
+    }
+    for (string line: forfeitLines) {
+        printf("%s\n", line.c_str());
+    }
+    printf("\n%ld %s games in %.2f s on %d threads (%.0f games/s)\n", totalGames, ruleset == salvo ? "salvo" : "classic",
+        seconds, workerCount, totalGames / seconds);
+
+    return 0;
+};